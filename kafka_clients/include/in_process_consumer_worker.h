@@ -0,0 +1,89 @@
+#ifndef IN_PROCESS_CONSUMER_WORKER_H
+#define IN_PROCESS_CONSUMER_WORKER_H
+
+#include "kafka_consumer_worker.h"
+#include "in_process_topic.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Consumer worker reading from in-process topics instead of a kafka broker. Allows services running in
+     * the same process to exchange messages without a broker hop. Consumed messages share the produced payload.
+     */
+    class in_process_consumer_worker : public kafka_consumer_worker
+    {
+        private:
+            /**
+             * @brief Topic consumer is subscribed to and its read position.
+             */
+            struct subscription
+            {
+                std::shared_ptr<in_process_topic> topic;
+                // Next offset to read from topic. Atomic since statistics are read from other threads.
+                std::atomic<int64_t> offset{0};
+            };
+
+            std::vector<std::string> _topics;
+            std::string _topics_str = "";
+            std::string _group_id_str = "";
+            int64_t _start_offset = RdKafka::Topic::OFFSET_END;
+            std::vector<std::unique_ptr<subscription>> _subscriptions;
+            // Subscription to read first on the next read, rotated so no topic starves the others
+            size_t _next_subscription = 0;
+            std::atomic<bool> _run{false};
+            std::atomic<int64_t> _rxmsgs{0};
+            /**
+             * @brief Read next record from any subscribed topic without waiting.
+             *
+             * @param record read record.
+             * @return true if a record was read.
+             * @return false if no subscribed topic has an unread record.
+             */
+            bool try_read(in_process_record &record);
+            /**
+             * @brief Wait up to timeout_ms for the next record.
+             *
+             * @param record read record.
+             * @param timeout_ms timeout in milliseconds to wait before failing.
+             * @return true if a record was read.
+             * @return false on timeout or if consumer is stopped.
+             */
+            bool read_next(in_process_record &record, int timeout_ms);
+
+        public:
+            /**
+             * @brief Construct a new in process consumer worker object
+             *
+             * @param topic_str topic consumer should consume from.
+             * @param group_id consumer group id. Only used for logging.
+             * @param cur_offset RdKafka::Topic::OFFSET_BEGINNING to start at the oldest retained record, otherwise
+             * consumption starts at the end of the topic.
+             */
+            in_process_consumer_worker(const std::string &topic_str, const std::string &group_id, int64_t cur_offset = RdKafka::Topic::OFFSET_END);
+            /**
+             * @brief Construct a new in process consumer worker object subscribing to several topics.
+             *
+             * @param topics topics consumer should consume from.
+             * @param group_id consumer group id. Only used for logging.
+             * @param cur_offset RdKafka::Topic::OFFSET_BEGINNING to start at the oldest retained record, otherwise
+             * consumption starts at the end of the topics.
+             */
+            in_process_consumer_worker(const std::vector<std::string> &topics, const std::string &group_id, int64_t cur_offset = RdKafka::Topic::OFFSET_END);
+            bool init() override;
+            /**
+             * @brief Get consumer statistics. Consumer lag is the number of records produced to the topic that were
+             * not consumed yet.
+             *
+             * @return kafka_statistics consumer statistics.
+             */
+            kafka_statistics get_statistics() const override;
+            kafka_message consume_message(int timeout_ms) override;
+            std::vector<kafka_message> consume_batch(size_t max_messages, int timeout_ms) override;
+            void subscribe() override;
+            void stop() override;
+            void printCurrConf() override;
+            bool is_running() const override;
+    };
+}
+
+#endif
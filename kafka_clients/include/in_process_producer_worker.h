@@ -0,0 +1,44 @@
+#ifndef IN_PROCESS_PRODUCER_WORKER_H
+#define IN_PROCESS_PRODUCER_WORKER_H
+
+#include "kafka_producer_worker.h"
+#include "in_process_topic.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Producer worker appending to an in-process topic instead of a kafka broker. Messages are visible to
+     * in-process consumers of the topic as soon as send() returns.
+     */
+    class in_process_producer_worker : public kafka_producer_worker
+    {
+        private:
+            std::string _topics_str = "";
+            std::shared_ptr<in_process_topic> _topic;
+            std::atomic<bool> _run{false};
+            std::atomic<uint64_t> _produced{0};
+
+        public:
+            /**
+             * @brief Construct a new in process producer worker object
+             *
+             * @param topic_str topic producer should produce to.
+             */
+            explicit in_process_producer_worker(const std::string &topic_str);
+            bool init() override;
+            void send(const std::string &msg) override;
+            void send(std::string &&msg) override;
+            /**
+             * @brief In-process topics have a single partition, the key is ignored.
+             */
+            void send(const std::string &msg, const std::string &key) override;
+            void send(std::string &&msg, const std::string &key) override;
+            producer_metrics get_metrics() const override;
+            kafka_statistics get_statistics() const override;
+            bool is_running() const override;
+            void stop() override;
+            void printCurrConf() override;
+    };
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef IN_PROCESS_TOPIC_H
+#define IN_PROCESS_TOPIC_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdint>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+#include <streets_singleton.h>
+
+namespace kafka_clients
+{
+    /**
+     * @brief Broker string prefix selecting the in-process transport instead of a kafka broker.
+     */
+    static const std::string IN_PROCESS_BROKER = "inproc";
+
+    /**
+     * @brief Message record read from an in-process topic.
+     */
+    struct in_process_record
+    {
+        // Payload shared between all consumers of the topic.
+        std::shared_ptr<const std::string> payload;
+        // Offset of record in topic.
+        int64_t offset = -1;
+        // Produce time in milliseconds since epoch.
+        int64_t timestamp = -1;
+        // Name of topic record was read from. Topics live as long as the process.
+        std::string_view topic;
+    };
+
+    /**
+     * @brief Bounded in-memory topic shared by in-process producers and consumers. Records are kept in a fixed
+     * size ring buffer. Producers claim offsets with an atomic counter and publish records through a per slot
+     * sequence number, so produce and consume share no topic wide lock. The shared payload pointer of a slot is
+     * accessed with std::atomic_load/std::atomic_store, which libstdc++ implements with a pool of mutexes keyed by
+     * address, so the ring buffer is not lock-free. Like a kafka topic, every consumer reads every
+     * record from its own offset. Once the ring wraps, the oldest records are overwritten and consumers that fall
+     * more than a ring capacity behind skip ahead to the oldest retained record.
+     */
+    class in_process_topic
+    {
+        private:
+            struct slot
+            {
+                // Offset + 1 of the record published in the slot. Holds the offset being written while a producer
+                // is writing the slot, which never matches the offset + 1 a reader of this slot expects.
+                std::atomic<int64_t> sequence{0};
+                // Accessed with std::atomic_load/std::atomic_store.
+                std::shared_ptr<const std::string> payload;
+                std::atomic<int64_t> timestamp{-1};
+            };
+
+            std::string _name;
+            std::vector<slot> _slots;
+            // Next offset to be claimed by a producer.
+            std::atomic<int64_t> _end_offset{0};
+
+        public:
+            /**
+             * @brief Construct a new in process topic.
+             *
+             * @param name topic name.
+             * @param capacity number of records retained by the ring buffer.
+             * @throws std::invalid_argument if capacity is less than 2. With a single slot, the sequence number of
+             * a slot being written matches the one of the published previous record.
+             */
+            in_process_topic(const std::string &name, size_t capacity);
+            /**
+             * @brief Append record to topic.
+             *
+             * @param payload shared payload.
+             * @return int64_t offset of appended record.
+             */
+            int64_t produce(std::shared_ptr<const std::string> payload);
+            /**
+             * @brief Read the record at offset. Advances offset past the record, or to the oldest retained record if
+             * the requested one has already been overwritten.
+             *
+             * @param offset offset to read. Updated to the next offset to read.
+             * @param record read record.
+             * @return true if a record was read.
+             * @return false if no record has been published at offset yet.
+             */
+            bool read(int64_t &offset, in_process_record &record) const;
+            /**
+             * @brief Offset of the next record to be produced.
+             *
+             * @return int64_t end offset.
+             */
+            int64_t end_offset() const;
+            /**
+             * @brief Offset of the oldest record still retained.
+             *
+             * @return int64_t begin offset.
+             */
+            int64_t begin_offset() const;
+            /**
+             * @brief Topic name.
+             *
+             * @return const std::string& name.
+             */
+            const std::string &name() const;
+    };
+
+    /**
+     * @brief Process wide registry of in-process topics. Producers and consumers created for the same topic name
+     * share one in_process_topic.
+     */
+    class in_process_broker : public streets_service::streets_singleton<in_process_broker>
+    {
+        friend class streets_service::streets_singleton<in_process_broker>;
+
+        private:
+            std::mutex _topics_mtx;
+            std::map<std::string, std::shared_ptr<in_process_topic>> _topics;
+            size_t _topic_capacity = 4096;
+
+            in_process_broker() = default;
+
+        public:
+            /**
+             * @brief Get topic with name, creating it on first use.
+             *
+             * @param name topic name.
+             * @return std::shared_ptr<in_process_topic> shared topic.
+             */
+            static std::shared_ptr<in_process_topic> get_topic(const std::string &name);
+            /**
+             * @brief Set ring buffer capacity of topics created after this call.
+             *
+             * @param capacity number of records retained per topic.
+             * @throws std::invalid_argument if capacity is less than 2.
+             */
+            static void set_topic_capacity(size_t capacity);
+    };
+}
+
+#endif
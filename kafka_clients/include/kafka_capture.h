@@ -0,0 +1,164 @@
+#ifndef KAFKA_CAPTURE_H
+#define KAFKA_CAPTURE_H
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+#include <spdlog/spdlog.h>
+
+#include "kafka_message.h"
+#include "kafka_producer_worker.h"
+
+namespace kafka_clients
+{
+    /**
+     * @brief Message record stored in a capture file.
+     */
+    struct capture_record
+    {
+        // Broker timestamp of message in milliseconds since epoch.
+        int64_t timestamp = -1;
+        std::string topic = "";
+        // Message key. Empty if message had no key.
+        std::string key = "";
+        std::string payload = "";
+    };
+
+    /**
+     * @brief Append-only writer of capture files. A capture file starts with the 4 byte magic "KCAP" and a 4 byte
+     * format version followed by records. Each record is a 16 byte header (int64 timestamp, uint16 topic length,
+     * uint16 key length, uint32 payload length) followed by topic, key and payload bytes. Integers are little endian.
+     */
+    class kafka_capture_writer
+    {
+        private:
+            std::ofstream _file;
+            uint64_t _record_count = 0;
+
+        public:
+            /**
+             * @brief Construct a new kafka capture writer. Truncates existing file at path.
+             *
+             * @param path capture file path.
+             */
+            explicit kafka_capture_writer(const std::string &path);
+            /**
+             * @brief Was the capture file opened successfully?
+             */
+            bool is_open() const;
+            /**
+             * @brief Append consumed message. Messages without broker timestamp are recorded with the current time.
+             *
+             * @param message consumed message.
+             * @return true if record was written.
+             */
+            bool write(const kafka_message &message);
+            /**
+             * @brief Append record.
+             *
+             * @param record record to append.
+             * @return true if record was written.
+             */
+            bool write(const capture_record &record);
+            /**
+             * @brief Flush buffered records to file.
+             */
+            void flush();
+            /**
+             * @brief Number of records written.
+             */
+            uint64_t get_record_count() const;
+    };
+
+    /**
+     * @brief Sequential reader of capture files written by kafka_capture_writer.
+     */
+    class kafka_capture_reader
+    {
+        private:
+            std::ifstream _file;
+            bool _valid = false;
+
+        public:
+            /**
+             * @brief Construct a new kafka capture reader.
+             *
+             * @param path capture file path.
+             */
+            explicit kafka_capture_reader(const std::string &path);
+            /**
+             * @brief Was a capture file with supported format version opened?
+             */
+            bool is_open() const;
+            /**
+             * @brief Read the next record.
+             *
+             * @param record read record.
+             * @return true if a record was read.
+             * @return false at end of file or if the last record is truncated.
+             */
+            bool next(capture_record &record);
+    };
+
+    /**
+     * @brief Result of replaying a capture file.
+     */
+    struct replay_result
+    {
+        uint64_t records = 0;
+        uint64_t bytes = 0;
+        // Wall clock duration of replay in milliseconds.
+        int64_t elapsed_ms = 0;
+        // Largest delay in milliseconds of a record behind its scaled capture time. Large values mean the
+        // target could not sustain the requested replay speed.
+        int64_t max_behind_schedule_ms = 0;
+    };
+
+    /**
+     * @brief Replays capture files into a kafka broker or the in-process transport. Records are produced to the topic
+     * they were captured from, keeping the spacing of broker timestamps divided by the replay speed.
+     */
+    class kafka_replayer
+    {
+        private:
+            std::string _broker_str;
+            // Replay speed factor. 1 is capture speed, 0 is as fast as possible.
+            double _speed = 1.0;
+            std::map<std::string, std::shared_ptr<kafka_producer_worker>> _producers;
+            std::atomic<bool> _run{true};
+            /**
+             * @brief Get producer for topic, creating and initializing it on first use.
+             *
+             * @return std::shared_ptr<kafka_producer_worker> producer or nullptr if it could not be initialized.
+             */
+            std::shared_ptr<kafka_producer_worker> get_producer(const std::string &topic);
+
+        public:
+            /**
+             * @brief Construct a new kafka replayer.
+             *
+             * @param broker_str network address of kafka broker or IN_PROCESS_BROKER to replay into in-process topics.
+             * @param speed replay speed factor, e.g. 1 for capture speed and 10 for 10 times capture speed. 0 or less
+             * replays as fast as possible.
+             */
+            kafka_replayer(const std::string &broker_str, double speed);
+            ~kafka_replayer();
+            /**
+             * @brief Replay all records of capture file. Blocks until the end of the file is reached or stop() is called.
+             *
+             * @param reader capture file reader.
+             * @return replay_result replay counters.
+             */
+            replay_result replay(kafka_capture_reader &reader);
+            /**
+             * @brief Stop a running replay.
+             */
+            void stop();
+    };
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "kafka_producer_worker.h"
 #include "kafka_consumer_worker.h"
+#include "in_process_producer_worker.h"
+#include "in_process_consumer_worker.h"
 #include <boost/thread.hpp>
 #include <boost/chrono.hpp>
 #include <spdlog/spdlog.h>
@@ -12,11 +14,44 @@
 namespace kafka_clients
 {
 
+    /**
+     * @brief Transport used by producers and consumers created by kafka_client.
+     */
+    enum class kafka_transport {
+        KAFKA = 0,      // Produce to and consume from a kafka broker.
+        IN_PROCESS = 1  // Exchange messages through in-process topics shared by all clients in the process.
+    };
+
     class kafka_client
     {
+    private:
+        kafka_transport _transport = kafka_transport::KAFKA;
+        /**
+         * @brief Should workers for broker_str use the in-process transport? True if the client was created for
+         * the in-process transport or the broker string starts with IN_PROCESS_BROKER, which allows switching a
+         * service to the in-process transport through its bootstrap server configuration.
+         */
+        bool use_in_process(const std::string &broker_str) const;
+
     public:
+        /**
+         * @brief Construct a new kafka client.
+         *
+         * @param transport transport used by created producers and consumers.
+         */
+        explicit kafka_client(kafka_transport transport = kafka_transport::KAFKA);
         std::shared_ptr<kafka_clients::kafka_consumer_worker> create_consumer(const std::string &broker_str, const std::string &topic_str,
                                                                               const std::string &group_id_str) const;
+        /**
+         * @brief Create a consumer subscribing to several topics. Messages report the topic they were consumed from.
+         *
+         * @param broker_str network address of kafka broker.
+         * @param topics topics to consume from.
+         * @param group_id_str consumer group id.
+         * @return std::shared_ptr<kafka_clients::kafka_consumer_worker> consumer.
+         */
+        std::shared_ptr<kafka_clients::kafka_consumer_worker> create_consumer(const std::string &broker_str, const std::vector<std::string> &topics,
+                                                                              const std::string &group_id_str) const;
         std::shared_ptr<kafka_clients::kafka_producer_worker> create_producer(const std::string &broker_str, const std::string &topic_str) const;
         rapidjson::Document read_json_file(const std::string &json_file) const;
         std::string get_value_by_doc(rapidjson::Document &doc, const char *key) const;
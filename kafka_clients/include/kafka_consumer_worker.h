@@ -7,6 +7,8 @@
 #include <cstdio>
 #include <csignal>
 #include <cstring>
+#include <vector>
+#include <atomic>
 #include <sys/time.h>
 #include <spdlog/spdlog.h>
 
@@ -22,6 +24,9 @@
 #endif
 
 #include <librdkafka/rdkafkacpp.h>
+#include "kafka_message.h"
+#include "kafka_statistics.h"
+
 namespace kafka_clients
 {
     static int partition_cnt = 0;
@@ -37,6 +42,11 @@ namespace kafka_clients
             }
 
         public:
+            // Number of times partitions were revoked from the consumer
+            std::atomic<uint64_t> revoked_cnt{0};
+            // Start consuming assigned partitions at the latest offset instead of the committed offset
+            std::atomic<bool> seek_to_latest{false};
+
             void rebalance_cb (RdKafka::KafkaConsumer *consumer, RdKafka::ErrorCode err, std::vector<RdKafka::TopicPartition*> &partitions) 
             {
                 SPDLOG_INFO("RebalanceCb: {0} ", RdKafka::err2str(err) );
@@ -46,14 +56,21 @@ namespace kafka_clients
                 RdKafka::ErrorCode ret_err = RdKafka::ERR_NO_ERROR;
 
                 if (err == RdKafka::ERR__ASSIGN_PARTITIONS) {
-                if (consumer->rebalance_protocol() == "COOPERATIVE")
-                    error = consumer->incremental_assign(partitions);
-                else
-                    ret_err = consumer->assign(partitions);
+                    if (seek_to_latest) 
+                    {
+                        // Skip backlog accumulated while partitions were unassigned
+                        for (auto partition : partitions)
+                            partition->set_offset(RdKafka::Topic::OFFSET_END);
+                    }
+                    if (consumer->rebalance_protocol() == "COOPERATIVE")
+                        error = consumer->incremental_assign(partitions);
+                    else
+                        ret_err = consumer->assign(partitions);
                     partition_cnt += (int)partitions.size();
                 } 
                 else 
                 {
+                    revoked_cnt++;
                     if (consumer->rebalance_protocol() == "COOPERATIVE") 
                     {
                         error = consumer->incremental_unassign(partitions);
@@ -76,6 +93,8 @@ namespace kafka_clients
     class consumer_event_cb : public RdKafka::EventCb 
     {
         public:
+            // Latest statistics emitted by librdkafka
+            kafka_statistics_store statistics;
             consumer_event_cb(){};
             ~consumer_event_cb(){};
             void event_cb (RdKafka::Event &event) 
@@ -91,7 +110,8 @@ namespace kafka_clients
                     break;
 
                 case RdKafka::Event::EVENT_STATS:
-                    SPDLOG_CRITICAL("{0} : Line {1}. STATS:  {2}  {3}",__FILE__, __LINE__, RdKafka::err2str(event.err()) ,event.str() );
+                    SPDLOG_TRACE("STATS: {0}", event.str());
+                    statistics.update(event.str());
                     break;
 
                 case RdKafka::Event::EVENT_LOG:
@@ -99,7 +119,8 @@ namespace kafka_clients
                     break;
 
                 case RdKafka::Event::EVENT_THROTTLE:
-                    SPDLOG_CRITICAL("{0} : Line {1}. THROTTLED: {2} ms by {3} id ",__FILE__, __LINE__, event.throttle_time(),(int)event.broker_id() );
+                    SPDLOG_WARN("THROTTLED: {0} ms by {1} id ", event.throttle_time(), (int)event.broker_id());
+                    statistics.throttled(event.throttle_time());
                     break;
 
                 default:
@@ -118,22 +139,53 @@ namespace kafka_clients
             const std::string GROUP_ID="group.id";
             const std::string MAX_PARTITION_FETCH_SIZE="max.partition.fetch.bytes";
             const std::string ENABLE_PARTITION_END_OF="enable.partition.eof";
+            const std::string STATISTICS_INTERVAL="statistics.interval.ms";
+            const std::string GROUP_INSTANCE_ID="group.instance.id";
 
             //maximum size for pulling message from a single partition at a time
             std::string STR_FETCH_NUM = "10240000";
             
             std::string _topics_str = "";
+            // Topics consumer subscribes to
+            std::vector<std::string> _topics;
             std::string _broker_str = "";
             std::string _group_id_str = "";
+            // Static group membership id. Empty for dynamic membership.
+            std::string _group_instance_id_str = "";
             int64_t _last_offset = 0;
             RdKafka::KafkaConsumer *_consumer = nullptr;
             RdKafka::Topic *_topic = nullptr;
             int64_t _cur_offet =  RdKafka::Topic::OFFSET_BEGINNING;
             int32_t _partition = 0;
             bool _run = false;
+            // Interval in milliseconds at which librdkafka emits statistics. 0 disables statistics.
+            int _statistics_interval_ms = 5000;
+            // Messages with a broker timestamp older than this are dropped. 0 disables dropping.
+            std::atomic<int> _max_message_age_ms{0};
+            std::atomic<uint64_t> _stale_dropped{0};
             consumer_event_cb _consumer_event_cb;
             consumer_rebalance_cb _consumer_rebalance_cb;
-            const char* msg_consume(RdKafka::Message *message, void *opaque);
+            // Copy of last payload returned by consume(). Only valid until next consume() call.
+            std::string _last_payload = "";
+            /**
+             * @brief Check consumed message for errors and log its state.
+             * 
+             * @param message consumed message.
+             * @return true if message holds a payload.
+             * @return false on timeout, end of partition or error.
+             */
+            bool msg_consume(const RdKafka::Message *message);
+
+        protected:
+            /**
+             * @brief Check whether message is older than the configured maximum message age and count it as dropped 
+             * if it is.
+             * 
+             * @param message consumed message.
+             * @return true if message is stale and should be dropped.
+             * @return false if message is fresh, has no timestamp or no maximum age is configured.
+             */
+            bool drop_if_stale(const kafka_message &message);
 
         public:
             /**
@@ -146,6 +198,18 @@ namespace kafka_clients
              * @param partition partition consumer should be assigned to.
              */
             kafka_consumer_worker(const std::string &broker_str, const std::string &topic_str, const std::string & group_id, int64_t cur_offset = 0, int32_t partition = 0);
+            /**
+             * @brief Construct a new kafka consumer worker object subscribing to several topics. Each consumed message
+             * reports the topic it was consumed from (see kafka_message::topic()), so a single consumer and dispatch
+             * loop can serve all topics.
+             * 
+             * @param broker_str network adress of kafka broker.
+             * @param topics topics consumer should consume from.
+             * @param group_id consumer group id.
+             * @param cur_offset offset to start event consuming at. Defaults to 0.
+             * @param partition partition consumer should be assigned to.
+             */
+            kafka_consumer_worker(const std::string &broker_str, const std::vector<std::string> &topics, const std::string & group_id, int64_t cur_offset = 0, int32_t partition = 0);
             /**
              * @brief Initialize kafka_consumer_worker
              * 
@@ -154,12 +218,82 @@ namespace kafka_clients
              */
             virtual bool init();
             /**
-             * @brief Consume from topic.
+             * @brief Set interval at which librdkafka statistics are collected. Must be called before init().
+             * 
+             * @param interval_ms statistics interval in milliseconds. 0 disables statistics.
+             */
+            void set_statistics_interval(int interval_ms);
+            /**
+             * @brief Get latest consumer statistics, including per partition consumer lag and broker round trip
+             * times.
+             * 
+             * @return kafka_statistics latest statistics. Empty until the first statistics interval elapsed.
+             */
+            virtual kafka_statistics get_statistics() const;
+            /**
+             * @brief Set static group membership id. Must be called before init(). Consumers of different groups
+             * with the same instance id are ordered the same by the range partition assignor, so instances consuming
+             * several co-partitioned topics through separate consumer groups are assigned the same partitions of
+             * each topic.
+             * 
+             * @param group_instance_id unique id of the service instance within the consumer group.
+             */
+            void set_group_instance_id(const std::string &group_instance_id);
+            /**
+             * @brief Number of times partitions were revoked from this consumer by a group rebalance. State derived
+             * from messages of revoked partitions may now be owned by another group member.
+             * 
+             * @return uint64_t revocation count.
+             */
+            virtual uint64_t get_revoked_count() const;
+            /**
+             * @brief Freshness first consumption. Seek to the latest offset whenever partitions are assigned, skipping
+             * any backlog produced while the consumer was down or partitions were rebalanced. Must be called before 
+             * subscribe().
+             * 
+             * @param seek_to_latest true to start at the latest offset on assignment.
+             */
+            void set_seek_to_latest(bool seek_to_latest);
+            /**
+             * @brief Drop consumed messages whose broker timestamp is older than max_age_ms before returning them.
+             * Bounds the time spent on stale messages after a restart. Assumes broker and consumer clocks are 
+             * synchronized.
+             * 
+             * @param max_age_ms maximum message age in milliseconds. 0 disables dropping.
+             */
+            void set_max_message_age(int max_age_ms);
+            /**
+             * @brief Number of messages dropped for exceeding the maximum message age.
+             * 
+             * @return uint64_t dropped message count.
+             */
+            uint64_t get_stale_dropped_count() const;
+            /**
+             * @brief Consume from topic. Copies the payload into a buffer owned by the consumer worker. Prefer 
+             * consume_message() which avoids the copy.
              * 
              * @param timeout_ms timeout in milliseconds to wait before failing.;
-             * @return const char* of payload consumed.
+             * @return const char* of payload consumed. Only valid until the next call to consume().
              */
             virtual const char* consume(int timeout_ms);
+            /**
+             * @brief Consume a message from topic without copying the payload.
+             * 
+             * @param timeout_ms timeout in milliseconds to wait before failing.
+             * @return kafka_message owning handle to consumed message. Empty on timeout, end of partition or error.
+             */
+            virtual kafka_message consume_message(int timeout_ms);
+            /**
+             * @brief Consume up to max_messages from topic in a single call. Blocks up to timeout_ms for the first 
+             * message and then drains any messages already fetched by the consumer without blocking. Allows callers to
+             * process a whole batch under a single lock acquisition.
+             * 
+             * @param max_messages maximum number of messages to return.
+             * @param timeout_ms timeout in milliseconds to wait for the first message.
+             * End of partition events are skipped, the batch ends on timeout or error.
+             * @return std::vector<kafka_message> consumed messages in order. Empty on timeout or error.
+             */
+            virtual std::vector<kafka_message> consume_batch(size_t max_messages, int timeout_ms);
             /**
              * @brief Subscribe consumer to topic
              */
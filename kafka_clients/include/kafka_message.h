@@ -0,0 +1,106 @@
+#ifndef KAFKA_MESSAGE_H
+#define KAFKA_MESSAGE_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+#include <librdkafka/rdkafkacpp.h>
+
+namespace kafka_clients
+{
+    /**
+     * @brief Owning handle to a single consumed kafka message. Wraps the RdKafka::Message returned by the
+     * consumer and releases it when the handle goes out of scope. The payload is exposed as a length-aware
+     * std::string_view into the librdkafka buffer so it can be parsed without copying. The view is only valid
+     * for the lifetime of the handle. Messages consumed from the in-process transport share the produced payload
+     * instead of wrapping an RdKafka::Message.
+     */
+    class kafka_message
+    {
+        private:
+            std::unique_ptr<RdKafka::Message> _message;
+            // Payload shared with the in-process transport. Only set if no RdKafka::Message is held.
+            std::shared_ptr<const std::string> _shared_payload;
+            int64_t _shared_offset = RdKafka::Topic::OFFSET_INVALID;
+            int64_t _shared_timestamp = -1;
+            // Topic name, cached on construction. Points into the topic handle of the RdKafka::Message, or to the
+            // name of the in-process topic.
+            std::string_view _topic;
+
+        public:
+            /**
+             * @brief Construct an empty kafka message handle.
+             */
+            kafka_message() = default;
+            /**
+             * @brief Construct a kafka message handle taking ownership of the provided RdKafka::Message.
+             *
+             * @param message consumed message. Ownership is transferred to the handle.
+             */
+            explicit kafka_message(RdKafka::Message *message);
+            /**
+             * @brief Construct a kafka message handle sharing a payload produced in process.
+             *
+             * @param payload shared payload.
+             * @param offset offset of message in topic.
+             * @param timestamp produce time in milliseconds since epoch.
+             * @param topic name of topic message was consumed from. Must outlive the handle.
+             */
+            kafka_message(std::shared_ptr<const std::string> payload, int64_t offset, int64_t timestamp, std::string_view topic = std::string_view());
+
+            kafka_message(kafka_message &&) noexcept = default;
+            kafka_message &operator=(kafka_message &&) noexcept = default;
+            kafka_message(const kafka_message &) = delete;
+            kafka_message &operator=(const kafka_message &) = delete;
+            ~kafka_message() = default;
+            /**
+             * @brief Does the handle hold a message with a payload?
+             *
+             * @return true if no message (timeout, end of partition, error) or an empty payload was consumed.
+             * @return false if handle holds a message payload.
+             */
+            bool empty() const;
+            /**
+             * @brief Message payload.
+             *
+             * @return std::string_view of payload. Not null terminated. Empty if no message is held.
+             */
+            std::string_view payload() const;
+            /**
+             * @brief Offset of message in partition.
+             *
+             * @return int64_t offset or RdKafka::Topic::OFFSET_INVALID if no message is held.
+             */
+            int64_t offset() const;
+            /**
+             * @brief Broker timestamp of message in milliseconds since epoch. Depending on topic configuration
+             * this is either the create time or the log append time.
+             *
+             * @return int64_t timestamp in milliseconds or -1 if not available.
+             */
+            int64_t timestamp() const;
+            /**
+             * @brief Partition the message was consumed from.
+             *
+             * @return int32_t partition or RdKafka::Topic::PARTITION_UA if no message is held.
+             */
+            int32_t partition() const;
+            /**
+             * @brief Message key.
+             *
+             * @return std::string_view of key. Empty if message has no key or no message is held.
+             */
+            std::string_view key() const;
+            /**
+             * @brief Name of topic the message was consumed from. Allows a consumer subscribed to several topics to
+             * dispatch messages by topic.
+             *
+             * @return std::string_view topic name, valid for the lifetime of the handle. Empty if no message is held.
+             */
+            std::string_view topic() const;
+    };
+}
+
+#endif
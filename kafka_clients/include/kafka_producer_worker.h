@@ -7,19 +7,64 @@
 #include <cstdio>
 #include <csignal>
 #include <cstring>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
 #if _AIX
 #include <unistd.h>
 #endif
 
 #include <librdkafka/rdkafkacpp.h>
 #include <spdlog/spdlog.h>
+#include "kafka_statistics.h"
 
 
 namespace kafka_clients
 {  
+    /**
+     * @brief Policy applied when the local librdkafka producer queue is full.
+     */
+    enum class queue_full_policy {
+        BLOCK = 0,          // Wait for queue space up to the configured deadline, then drop the new message.
+        DROP_NEWEST = 1,    // Drop the new message immediately.
+        DROP_QUEUED = 2     // Purge all messages waiting in the local queue of the producer, not only the oldest one,
+                            // and enqueue the new message. Messages already in flight to the broker are kept. Only
+                            // for topics where the newest message supersedes all queued ones, like schedules or SPaT.
+    };
+
+    /**
+     * @brief Snapshot of producer counters.
+     */
+    struct producer_metrics {
+        // Messages accepted into the local producer queue.
+        uint64_t produced = 0;
+        // Messages acknowledged by the broker.
+        uint64_t delivered = 0;
+        // Messages that failed delivery.
+        uint64_t failed = 0;
+        // Messages dropped by the queue full policy (including purged messages).
+        uint64_t dropped = 0;
+        // Delivery latency in microseconds of the most recently delivered message.
+        int64_t last_delivery_latency_us = 0;
+        // Maximum delivery latency in microseconds.
+        int64_t max_delivery_latency_us = 0;
+        // Average delivery latency in microseconds.
+        double avg_delivery_latency_us = 0;
+        // Messages currently waiting in the local queue or in flight.
+        int queue_depth = 0;
+    };
+
     class producer_delivery_report_cb : public RdKafka::DeliveryReportCb
     {
         public:
+            std::atomic<uint64_t> delivered{0};
+            std::atomic<uint64_t> failed{0};
+            std::atomic<uint64_t> purged{0};
+            std::atomic<int64_t> total_latency_us{0};
+            std::atomic<int64_t> last_latency_us{0};
+            std::atomic<int64_t> max_latency_us{0};
+
             producer_delivery_report_cb(){
 
             };
@@ -30,12 +75,34 @@ namespace kafka_clients
             {
                 SPDLOG_TRACE("Message dellivery for:  {0} bytes [ {1} ]",message.len(), message.errstr().c_str());
                 if(message.key())                 
-                    SPDLOG_INFO(" Key:  {:>8}",(char*)(message.key()));
+                    SPDLOG_TRACE(" Key:  {:>8}",*message.key());
+                if (message.err() == RdKafka::ERR_NO_ERROR) 
+                {
+                    delivered++;
+                    int64_t latency = message.latency();
+                    total_latency_us += latency;
+                    last_latency_us = latency;
+                    int64_t cur_max = max_latency_us.load();
+                    while (latency > cur_max && !max_latency_us.compare_exchange_weak(cur_max, latency));
+                }
+                else if (message.err() == RdKafka::ERR__PURGE_QUEUE) 
+                {
+                    purged++;
+                }
+                else 
+                {
+                    failed++;
+                }
+                /* Payloads produced without RK_MSG_COPY carry the owning std::string as message opaque.
+                 * Release it once librdkafka is done with the payload (delivered, failed or purged). */
+                delete static_cast<std::string *>(message.msg_opaque());
             }
     };
     class producer_event_cb:public RdKafka::EventCb
     {
         public:
+            // Latest statistics emitted by librdkafka
+            kafka_statistics_store statistics;
             producer_event_cb(){
 
             };
@@ -48,10 +115,14 @@ namespace kafka_clients
                 {
                 case RdKafka::Event::EVENT_ERROR:                 
                     SPDLOG_CRITICAL("ERROR:  {0}  {1}", RdKafka::err2str(event.err()) ,event.str() );
-                    if (event.err() == RdKafka::ERR__ALL_BROKERS_DOWN)
                     break;
                 case RdKafka::Event::EVENT_STATS:
-                    SPDLOG_CRITICAL("STATS: {0}  {1}", RdKafka::err2str(event.err()) ,event.str() );
+                    SPDLOG_TRACE("STATS: {0}", event.str());
+                    statistics.update(event.str());
+                    break;
+                case RdKafka::Event::EVENT_THROTTLE:
+                    SPDLOG_WARN("THROTTLED: {0} ms by {1} id ", event.throttle_time(), (int)event.broker_id());
+                    statistics.throttled(event.throttle_time());
                     break;
                 case RdKafka::Event::EVENT_LOG:
                     SPDLOG_CRITICAL("LOG:  {0}  {1}", RdKafka::err2str(event.err()) ,event.str() );
@@ -69,15 +140,70 @@ namespace kafka_clients
             const std::string BOOTSTRAP_SERVER="bootstrap.servers";
             const std::string DR_CB="dr_cb";
             const std::string EVENT_CB="event_cb";
+            const std::string STATISTICS_INTERVAL="statistics.interval.ms";
+            const std::string PARTITIONER="partitioner";
+            // Java client compatible partitioner so keyed messages from all producers land on the same partition
+            const std::string PARTITIONER_MURMUR2="murmur2_random";
 
             RdKafka::Producer *_producer = nullptr;
             RdKafka::Topic *_topic = nullptr;
             std::string _topics_str = "";
             std::string _broker_str = "";
-            bool _run = false;
+            std::atomic<bool> _run{false};
             int _partition = 0;
+            // Interval in milliseconds at which librdkafka emits statistics. 0 disables statistics.
+            int _statistics_interval_ms = 5000;
             producer_delivery_report_cb _producer_delivery_report_cb;
             producer_event_cb _producer_event_cb;
+            // Serve delivery reports on a dedicated thread instead of polling inline in send()
+            bool _async = false;
+            std::thread _poll_thread;
+            // Poll interval for the dedicated poll thread in milliseconds
+            int _poll_interval_ms = 100;
+            queue_full_policy _queue_full_policy = queue_full_policy::BLOCK;
+            // Maximum time in milliseconds send() blocks on a full queue under queue_full_policy::BLOCK
+            int _queue_full_timeout_ms = 1000;
+            std::atomic<uint64_t> _produced{0};
+            std::atomic<uint64_t> _dropped{0};
+            /**
+             * @brief Serve delivery report and event callbacks until producer is stopped.
+             */
+            void poll_loop();
+            /**
+             * @brief Apply queue full policy after a produce attempt failed with ERR__QUEUE_FULL.
+             * 
+             * @param deadline time after which a blocking send gives up.
+             * @return true if produce should be retried.
+             * @return false if message should be dropped.
+             */
+            bool handle_queue_full(const std::chrono::steady_clock::time_point &deadline);
+            /**
+             * @brief Produce payload to topic applying the queue full policy.
+             * 
+             * @param payload pointer to payload.
+             * @param len payload length in bytes.
+             * @param msgflags RdKafka::Producer message flags (RK_MSG_COPY or 0).
+             * @param msg_opaque per message opaque passed to the delivery report callback.
+             * @param key message key. If set the partition is selected by hashing the key, otherwise the message is
+             * produced to the configured partition.
+             * @return true if payload was accepted into the local producer queue.
+             * @return false if payload was dropped or produce failed.
+             */
+            bool produce(char *payload, size_t len, int msgflags, void *msg_opaque, const std::string *key = nullptr);
+            /**
+             * @brief Copy message into the producer queue and serve delivery reports if not async.
+             * 
+             * @param msg message to produce.
+             * @param key optional message key.
+             */
+            void send_copy(const std::string &msg, const std::string *key);
+            /**
+             * @brief Transfer message ownership to the producer queue and serve delivery reports if not async.
+             * 
+             * @param msg message to produce. Moved from.
+             * @param key optional message key.
+             */
+            void send_owned(std::string &&msg, const std::string *key);
 
         public:
             /**
@@ -95,12 +221,70 @@ namespace kafka_clients
              * @return false if unsuccessful.
              */
             virtual bool init();
+            /**
+             * @brief Serve delivery reports on a dedicated poll thread so send() never polls inline. Must be called
+             * before init().
+             * 
+             * @param async true to enable the dedicated poll thread.
+             * @param poll_interval_ms maximum time in milliseconds the poll thread blocks in each poll call.
+             */
+            void set_async(bool async, int poll_interval_ms = 100);
+            /**
+             * @brief Set the policy applied when the local producer queue is full.
+             * 
+             * @param policy queue full policy.
+             * @param block_timeout_ms maximum time in milliseconds send() waits for queue space under 
+             * queue_full_policy::BLOCK.
+             */
+            void set_queue_full_policy(queue_full_policy policy, int block_timeout_ms = 1000);
+            /**
+             * @brief Get snapshot of delivery latency and queue depth counters.
+             * 
+             * @return producer_metrics 
+             */
+            virtual producer_metrics get_metrics() const;
+            /**
+             * @brief Set interval at which librdkafka statistics are collected. Must be called before init().
+             * 
+             * @param interval_ms statistics interval in milliseconds. 0 disables statistics.
+             */
+            void set_statistics_interval(int interval_ms);
+            /**
+             * @brief Get latest producer statistics, including per partition transmitted and queued messages and 
+             * broker round trip times.
+             * 
+             * @return kafka_statistics latest statistics. Empty until the first statistics interval elapsed.
+             */
+            virtual kafka_statistics get_statistics() const;
             /**
              * @brief Produce to topic.
              * 
              * @param msg message to produce.
              */
             virtual void send(const std::string &msg);
+            /**
+             * @brief Produce to topic taking ownership of the message. The payload buffer is handed to librdkafka
+             * without being copied and released from the delivery report callback once delivered, failed or purged.
+             * Use for serialized messages that are not needed after sending.
+             * 
+             * @param msg message to produce. Moved from.
+             */
+            virtual void send(std::string &&msg);
+            /**
+             * @brief Produce keyed message to topic. The partition is selected by hashing the key so all messages
+             * with the same key are produced to the same partition.
+             * 
+             * @param msg message to produce.
+             * @param key message key, e.g. vehicle id.
+             */
+            virtual void send(const std::string &msg, const std::string &key);
+            /**
+             * @brief Produce keyed message to topic taking ownership of the message. See send(std::string &&).
+             * 
+             * @param msg message to produce. Moved from.
+             * @param key message key, e.g. vehicle id.
+             */
+            virtual void send(std::string &&msg, const std::string &key);
             /**
              * @brief Is kafka_producer_worker still running?
              * 
@@ -117,10 +301,10 @@ namespace kafka_clients
              */
             virtual void printCurrConf();
             /**
-             * @brief Destroy the kafka producer worker object
+             * @brief Destroy the kafka producer worker object. Joins the poll thread if running.
              * 
              */
-            virtual ~kafka_producer_worker() = default;
+            virtual ~kafka_producer_worker();
         };
 }
 
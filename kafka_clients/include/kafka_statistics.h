@@ -0,0 +1,125 @@
+#ifndef KAFKA_STATISTICS_H
+#define KAFKA_STATISTICS_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+#include <rapidjson/document.h>
+#include <spdlog/spdlog.h>
+
+namespace kafka_clients
+{
+    /**
+     * @brief Statistics of a single broker connection.
+     */
+    struct broker_statistics
+    {
+        // Broker name (host:port/id).
+        std::string name = "";
+        // Broker id, -1 for bootstrap brokers.
+        int32_t node_id = -1;
+        // Requests waiting to be sent to or awaiting response from broker.
+        int64_t outbuf_cnt = 0;
+        // Average broker round trip time in microseconds.
+        int64_t rtt_avg_us = 0;
+        // 99th percentile of broker round trip time in microseconds.
+        int64_t rtt_p99_us = 0;
+    };
+
+    /**
+     * @brief Statistics of a single topic partition.
+     */
+    struct partition_statistics
+    {
+        std::string topic = "";
+        int32_t partition = -1;
+        // Difference between partition high watermark and consumer position, -1 if unknown.
+        int64_t consumer_lag = -1;
+        // Messages received (consumer).
+        int64_t rxmsgs = 0;
+        // Messages transmitted (producer).
+        int64_t txmsgs = 0;
+        // Messages waiting in the producer queues of the partition.
+        int64_t outq_msgs = 0;
+    };
+
+    /**
+     * @brief Typed snapshot of the librdkafka statistics emitted every statistics.interval.ms.
+     */
+    struct kafka_statistics
+    {
+        // Time of the snapshot in microseconds since epoch. 0 if no statistics were received yet.
+        int64_t timestamp_us = 0;
+        // Messages received in total (consumer).
+        int64_t rxmsgs = 0;
+        // Messages transmitted in total (producer).
+        int64_t txmsgs = 0;
+        // Messages in producer queues.
+        int64_t outq_msgs = 0;
+        // Number of times requests to the broker were throttled since the client was created.
+        uint64_t throttle_count = 0;
+        // Last broker throttle time in milliseconds.
+        int last_throttle_time_ms = 0;
+        std::vector<broker_statistics> brokers;
+        std::vector<partition_statistics> partitions;
+
+        /**
+         * @brief Sum of consumer lag over all partitions of topic with known lag.
+         *
+         * @param topic topic name.
+         * @return int64_t total consumer lag or -1 if lag of no partition of the topic is known.
+         */
+        int64_t consumer_lag(const std::string &topic) const;
+        /**
+         * @brief Largest 99th percentile round trip time over all brokers.
+         *
+         * @return int64_t round trip time in microseconds.
+         */
+        int64_t max_rtt_p99_us() const;
+    };
+
+    /**
+     * @brief Parse librdkafka statistics JSON.
+     *
+     * @param json statistics JSON emitted with RdKafka::Event::EVENT_STATS.
+     * @param stats parsed statistics. Throttle counters are left unchanged.
+     * @return true if statistics were parsed.
+     * @return false if JSON could not be parsed.
+     */
+    bool parse_statistics(const std::string &json, kafka_statistics &stats);
+
+    /**
+     * @brief Latest statistics received by an event callback. Updated from the librdkafka callback thread and read
+     * by the worker objects.
+     */
+    class kafka_statistics_store
+    {
+        private:
+            mutable std::mutex _stats_mtx;
+            kafka_statistics _stats;
+
+        public:
+            /**
+             * @brief Replace stored statistics with parsed statistics JSON.
+             *
+             * @param json statistics JSON.
+             */
+            void update(const std::string &json);
+            /**
+             * @brief Record a throttle event.
+             *
+             * @param throttle_time_ms throttle time in milliseconds.
+             */
+            void throttled(int throttle_time_ms);
+            /**
+             * @brief Get copy of latest statistics.
+             *
+             * @return kafka_statistics latest statistics.
+             */
+            kafka_statistics get() const;
+    };
+}
+
+#endif
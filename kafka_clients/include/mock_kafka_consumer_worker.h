@@ -31,6 +31,8 @@ namespace kafka_clients {
 
             MOCK_METHOD(bool, init,(),(override));
             MOCK_METHOD(const char*, consume, (int timeout_ms), (override));
+            MOCK_METHOD(kafka_message, consume_message, (int timeout_ms), (override));
+            MOCK_METHOD(std::vector<kafka_message>, consume_batch, (size_t max_messages, int timeout_ms), (override));
             MOCK_METHOD(void, subscribe, (), (override));
             MOCK_METHOD(void, stop, (), (override));
             MOCK_METHOD(void, printCurrConf, (), (override));
@@ -26,6 +26,12 @@ namespace kafka_clients {
             ~mock_kafka_producer_worker() = default;
             MOCK_METHOD(bool, init,(),(override));
             MOCK_METHOD(void, send, (const std::string &msg), (override));
+            /**
+             * @brief Forward ownership taking send to the mocked send so expectations on send(_) cover both.
+             */
+            void send(std::string &&msg) override { send(static_cast<const std::string &>(msg)); }
+            MOCK_METHOD(void, send, (const std::string &msg, const std::string &key), (override));
+            void send(std::string &&msg, const std::string &key) override { send(static_cast<const std::string &>(msg), key); }
             MOCK_METHOD(bool, is_running, (), (const, override));
             MOCK_METHOD(void, stop, (), (override));
             MOCK_METHOD(void, printCurrConf, (), (override));
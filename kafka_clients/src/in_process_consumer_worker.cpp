@@ -0,0 +1,161 @@
+#include "in_process_consumer_worker.h"
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+namespace kafka_clients
+{
+    in_process_consumer_worker::in_process_consumer_worker(const std::string &topic_str, const std::string &group_id, int64_t cur_offset)
+        : in_process_consumer_worker(std::vector<std::string>{topic_str}, group_id, cur_offset)
+    {
+    }
+
+    in_process_consumer_worker::in_process_consumer_worker(const std::vector<std::string> &topics, const std::string &group_id, int64_t cur_offset)
+        : kafka_consumer_worker(IN_PROCESS_BROKER, topics, group_id, cur_offset), _topics(topics), _group_id_str(group_id), _start_offset(cur_offset)
+    {
+        for (const auto &topic : _topics)
+        {
+            _topics_str += _topics_str.empty() ? topic : "," + topic;
+        }
+    }
+
+    bool in_process_consumer_worker::init()
+    {
+        SPDLOG_INFO("in_process_consumer_worker init()... ");
+        _subscriptions.clear();
+        for (const auto &topic : _topics)
+        {
+            auto sub = std::make_unique<subscription>();
+            sub->topic = in_process_broker::get_topic(topic);
+            _subscriptions.push_back(std::move(sub));
+        }
+        printCurrConf();
+        return true;
+    }
+
+    kafka_statistics in_process_consumer_worker::get_statistics() const
+    {
+        kafka_statistics stats;
+        stats.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        stats.rxmsgs = _rxmsgs;
+        if (!_run)
+        {
+            return stats;
+        }
+        for (const auto &sub : _subscriptions)
+        {
+            partition_statistics part_stats;
+            part_stats.topic = sub->topic->name();
+            part_stats.partition = 0;
+            part_stats.consumer_lag = std::max<int64_t>(0, sub->topic->end_offset() - std::max(sub->offset.load(), sub->topic->begin_offset()));
+            stats.partitions.push_back(part_stats);
+        }
+        return stats;
+    }
+
+    void in_process_consumer_worker::subscribe()
+    {
+        for (auto &sub : _subscriptions)
+        {
+            sub->offset = _start_offset == RdKafka::Topic::OFFSET_BEGINNING ? sub->topic->begin_offset() : sub->topic->end_offset();
+            SPDLOG_INFO("Successfully subscribed to in-process topic {0} at offset {1}", sub->topic->name(), sub->offset.load());
+        }
+        _run = true;
+    }
+
+    bool in_process_consumer_worker::try_read(in_process_record &record)
+    {
+        for (size_t i = 0; i < _subscriptions.size(); i++)
+        {
+            auto &sub = *_subscriptions[(_next_subscription + i) % _subscriptions.size()];
+            int64_t offset = sub.offset;
+            bool has_record = sub.topic->read(offset, record);
+            sub.offset = offset;
+            if (has_record)
+            {
+                _next_subscription = (_next_subscription + i + 1) % _subscriptions.size();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool in_process_consumer_worker::read_next(in_process_record &record, int timeout_ms)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        int spins = 0;
+        while (_run)
+        {
+            if (try_read(record))
+            {
+                _rxmsgs++;
+                return true;
+            }
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            // Back off from spinning to sleeping so idle consumers do not occupy a core
+            if (spins < 100)
+            {
+                spins++;
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        return false;
+    }
+
+    kafka_message in_process_consumer_worker::consume_message(int timeout_ms)
+    {
+        in_process_record record;
+        if (!read_next(record, timeout_ms))
+        {
+            return kafka_message();
+        }
+        kafka_message message(std::move(record.payload), record.offset, record.timestamp, record.topic);
+        if (drop_if_stale(message))
+        {
+            return kafka_message();
+        }
+        return message;
+    }
+
+    std::vector<kafka_message> in_process_consumer_worker::consume_batch(size_t max_messages, int timeout_ms)
+    {
+        std::vector<kafka_message> batch;
+        batch.reserve(max_messages);
+        in_process_record record;
+        int wait_ms = timeout_ms;
+        while (batch.size() < max_messages && read_next(record, wait_ms))
+        {
+            kafka_message message(std::move(record.payload), record.offset, record.timestamp, record.topic);
+            if (!message.empty() && !drop_if_stale(message))
+            {
+                batch.push_back(std::move(message));
+            }
+            // Only block for the first message
+            wait_ms = 0;
+        }
+        return batch;
+    }
+
+    void in_process_consumer_worker::stop()
+    {
+        _run = false;
+        SPDLOG_WARN("Stopped in-process consumer of topics {0}", _topics_str);
+    }
+
+    void in_process_consumer_worker::printCurrConf()
+    {
+        SPDLOG_INFO("Consumer connect to in-process topic: {0}, group_id: {1}", _topics_str, _group_id_str);
+    }
+
+    bool in_process_consumer_worker::is_running() const
+    {
+        return _run;
+    }
+}
@@ -0,0 +1,75 @@
+#include "in_process_producer_worker.h"
+
+namespace kafka_clients
+{
+    in_process_producer_worker::in_process_producer_worker(const std::string &topic_str)
+        : kafka_producer_worker(IN_PROCESS_BROKER, topic_str), _topics_str(topic_str)
+    {
+    }
+
+    bool in_process_producer_worker::init()
+    {
+        SPDLOG_INFO("in_process_producer_worker init()... ");
+        _topic = in_process_broker::get_topic(_topics_str);
+        _run = true;
+        printCurrConf();
+        return true;
+    }
+
+    void in_process_producer_worker::send(const std::string &msg)
+    {
+        send(std::string(msg));
+    }
+
+    void in_process_producer_worker::send(std::string &&msg)
+    {
+        if (!_run || msg.empty())
+            return;
+        int64_t offset = _topic->produce(std::make_shared<const std::string>(std::move(msg)));
+        _produced++;
+        SPDLOG_TRACE("Produced message to in-process topic {0} at offset {1}", _topics_str, offset);
+    }
+
+    void in_process_producer_worker::send(const std::string &msg, const std::string &)
+    {
+        send(std::string(msg));
+    }
+
+    void in_process_producer_worker::send(std::string &&msg, const std::string &)
+    {
+        send(std::move(msg));
+    }
+
+    producer_metrics in_process_producer_worker::get_metrics() const
+    {
+        // Records are delivered as soon as they are appended to the topic
+        producer_metrics metrics;
+        metrics.produced = _produced;
+        metrics.delivered = _produced;
+        return metrics;
+    }
+
+    kafka_statistics in_process_producer_worker::get_statistics() const
+    {
+        kafka_statistics stats;
+        stats.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        stats.txmsgs = static_cast<int64_t>(_produced.load());
+        return stats;
+    }
+
+    bool in_process_producer_worker::is_running() const
+    {
+        return _run;
+    }
+
+    void in_process_producer_worker::stop()
+    {
+        _run = false;
+        SPDLOG_WARN("Stopped in-process producer of topic {0}", _topics_str);
+    }
+
+    void in_process_producer_worker::printCurrConf()
+    {
+        SPDLOG_INFO("Producer connect to in-process topic: {0}", _topics_str);
+    }
+}
@@ -0,0 +1,111 @@
+#include "in_process_topic.h"
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+namespace kafka_clients
+{
+    namespace
+    {
+        size_t checked_capacity(size_t capacity)
+        {
+            if (capacity < 2)
+            {
+                throw std::invalid_argument("In-process topic capacity " + std::to_string(capacity) + " is less than 2!");
+            }
+            return capacity;
+        }
+    }
+
+    in_process_topic::in_process_topic(const std::string &name, size_t capacity) : _name(name), _slots(checked_capacity(capacity))
+    {
+        // Slot i is free for offset i
+        for (size_t i = 0; i < _slots.size(); i++)
+        {
+            _slots[i].sequence.store(static_cast<int64_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    int64_t in_process_topic::produce(std::shared_ptr<const std::string> payload)
+    {
+        const auto capacity = static_cast<int64_t>(_slots.size());
+        int64_t offset = _end_offset.fetch_add(1, std::memory_order_relaxed);
+        slot &cur_slot = _slots[offset % capacity];
+        // Wait for the producer of the previous lap to publish before overwriting its record
+        int64_t expected = offset < capacity ? offset : offset - capacity + 1;
+        while (cur_slot.sequence.load(std::memory_order_acquire) != expected)
+        {
+            std::this_thread::yield();
+        }
+        cur_slot.sequence.store(offset, std::memory_order_release);
+        std::atomic_store(&cur_slot.payload, std::move(payload));
+        cur_slot.timestamp.store(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+        cur_slot.sequence.store(offset + 1, std::memory_order_release);
+        return offset;
+    }
+
+    bool in_process_topic::read(int64_t &offset, in_process_record &record) const
+    {
+        const auto capacity = static_cast<int64_t>(_slots.size());
+        while (true)
+        {
+            offset = std::max(offset, begin_offset());
+            const slot &cur_slot = _slots[offset % capacity];
+            if (cur_slot.sequence.load(std::memory_order_acquire) == offset + 1)
+            {
+                record.payload = std::atomic_load(&cur_slot.payload);
+                record.timestamp = cur_slot.timestamp.load(std::memory_order_relaxed);
+                // Record is only valid if the slot was not overwritten while reading
+                if (cur_slot.sequence.load(std::memory_order_acquire) == offset + 1)
+                {
+                    record.offset = offset;
+                    record.topic = _name;
+                    offset++;
+                    return true;
+                }
+            }
+            else if (offset >= begin_offset())
+            {
+                // Not published yet
+                return false;
+            }
+            SPDLOG_DEBUG("In-process consumer of topic {0} fell behind, skipping to offset {1}", _name, begin_offset());
+        }
+    }
+
+    int64_t in_process_topic::end_offset() const
+    {
+        return _end_offset.load(std::memory_order_acquire);
+    }
+
+    int64_t in_process_topic::begin_offset() const
+    {
+        return std::max<int64_t>(0, end_offset() - static_cast<int64_t>(_slots.size()));
+    }
+
+    const std::string &in_process_topic::name() const
+    {
+        return _name;
+    }
+
+    std::shared_ptr<in_process_topic> in_process_broker::get_topic(const std::string &name)
+    {
+        auto &broker = get_singleton();
+        std::unique_lock<std::mutex> lck(broker._topics_mtx);
+        auto itr = broker._topics.find(name);
+        if (itr == broker._topics.end())
+        {
+            SPDLOG_INFO("Creating in-process topic {0} with capacity {1}", name, broker._topic_capacity);
+            itr = broker._topics.emplace(name, std::make_shared<in_process_topic>(name, broker._topic_capacity)).first;
+        }
+        return itr->second;
+    }
+
+    void in_process_broker::set_topic_capacity(size_t capacity)
+    {
+        checked_capacity(capacity);
+        auto &broker = get_singleton();
+        std::unique_lock<std::mutex> lck(broker._topics_mtx);
+        broker._topic_capacity = capacity;
+    }
+}
@@ -0,0 +1,253 @@
+#include "kafka_capture.h"
+#include "kafka_client.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+namespace kafka_clients
+{
+    namespace
+    {
+        const char CAPTURE_MAGIC[4] = {'K', 'C', 'A', 'P'};
+        const uint32_t CAPTURE_VERSION = 1;
+        const size_t RECORD_HEADER_SIZE = 16;
+
+        void put_le(char *buf, uint64_t value, size_t size)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                buf[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+        }
+
+        uint64_t get_le(const char *buf, size_t size)
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(buf[i])) << (8 * i);
+            }
+            return value;
+        }
+    }
+
+    kafka_capture_writer::kafka_capture_writer(const std::string &path) : _file(path, std::ios::binary | std::ios::trunc)
+    {
+        if (!_file.is_open())
+        {
+            SPDLOG_ERROR("Failed to open capture file {0}", path);
+            return;
+        }
+        char header[8];
+        std::copy(std::begin(CAPTURE_MAGIC), std::end(CAPTURE_MAGIC), header);
+        put_le(header + 4, CAPTURE_VERSION, 4);
+        _file.write(header, sizeof(header));
+    }
+
+    bool kafka_capture_writer::is_open() const
+    {
+        return _file.is_open() && _file.good();
+    }
+
+    bool kafka_capture_writer::write(const kafka_message &message)
+    {
+        if (message.empty())
+        {
+            return false;
+        }
+        capture_record record;
+        record.timestamp = message.timestamp();
+        if (record.timestamp < 0)
+        {
+            record.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+        record.topic = std::string(message.topic());
+        record.key = std::string(message.key());
+        record.payload = std::string(message.payload());
+        return write(record);
+    }
+
+    bool kafka_capture_writer::write(const capture_record &record)
+    {
+        if (!is_open())
+        {
+            return false;
+        }
+        if (record.topic.size() > std::numeric_limits<uint16_t>::max() || record.key.size() > std::numeric_limits<uint16_t>::max()
+            || record.payload.size() > std::numeric_limits<uint32_t>::max())
+        {
+            SPDLOG_WARN("Record of topic {0} exceeds capture file field size limits and is skipped", record.topic);
+            return false;
+        }
+        char header[RECORD_HEADER_SIZE];
+        put_le(header, static_cast<uint64_t>(record.timestamp), 8);
+        put_le(header + 8, record.topic.size(), 2);
+        put_le(header + 10, record.key.size(), 2);
+        put_le(header + 12, record.payload.size(), 4);
+        _file.write(header, sizeof(header));
+        _file.write(record.topic.data(), record.topic.size());
+        _file.write(record.key.data(), record.key.size());
+        _file.write(record.payload.data(), record.payload.size());
+        if (!_file.good())
+        {
+            SPDLOG_ERROR("Failed to write capture record");
+            return false;
+        }
+        _record_count++;
+        return true;
+    }
+
+    void kafka_capture_writer::flush()
+    {
+        _file.flush();
+    }
+
+    uint64_t kafka_capture_writer::get_record_count() const
+    {
+        return _record_count;
+    }
+
+    kafka_capture_reader::kafka_capture_reader(const std::string &path) : _file(path, std::ios::binary)
+    {
+        if (!_file.is_open())
+        {
+            SPDLOG_ERROR("Failed to open capture file {0}", path);
+            return;
+        }
+        char header[8];
+        if (!_file.read(header, sizeof(header)) || !std::equal(std::begin(CAPTURE_MAGIC), std::end(CAPTURE_MAGIC), header))
+        {
+            SPDLOG_ERROR("{0} is not a capture file", path);
+            return;
+        }
+        auto version = static_cast<uint32_t>(get_le(header + 4, 4));
+        if (version != CAPTURE_VERSION)
+        {
+            SPDLOG_ERROR("Unsupported capture file version {0}", version);
+            return;
+        }
+        _valid = true;
+    }
+
+    bool kafka_capture_reader::is_open() const
+    {
+        return _valid;
+    }
+
+    bool kafka_capture_reader::next(capture_record &record)
+    {
+        if (!_valid)
+        {
+            return false;
+        }
+        char header[RECORD_HEADER_SIZE];
+        if (!_file.read(header, sizeof(header)))
+        {
+            if (_file.gcount() > 0)
+            {
+                SPDLOG_WARN("Capture file ends with truncated record");
+            }
+            return false;
+        }
+        record.timestamp = static_cast<int64_t>(get_le(header, 8));
+        record.topic.resize(get_le(header + 8, 2));
+        record.key.resize(get_le(header + 10, 2));
+        record.payload.resize(get_le(header + 12, 4));
+        if (!_file.read(record.topic.data(), record.topic.size()) || !_file.read(record.key.data(), record.key.size())
+            || !_file.read(record.payload.data(), record.payload.size()))
+        {
+            SPDLOG_WARN("Capture file ends with truncated record");
+            return false;
+        }
+        return true;
+    }
+
+    kafka_replayer::kafka_replayer(const std::string &broker_str, double speed) : _broker_str(broker_str), _speed(speed)
+    {
+    }
+
+    kafka_replayer::~kafka_replayer()
+    {
+        for (auto &[topic, producer] : _producers)
+        {
+            if (producer)
+            {
+                producer->stop();
+            }
+        }
+    }
+
+    std::shared_ptr<kafka_producer_worker> kafka_replayer::get_producer(const std::string &topic)
+    {
+        auto producer_itr = _producers.find(topic);
+        if (producer_itr != _producers.end())
+        {
+            return producer_itr->second;
+        }
+        kafka_client client;
+        auto producer = client.create_producer(_broker_str, topic);
+        if (!producer->init())
+        {
+            SPDLOG_ERROR("Failed to initialize replay producer for topic {0}. Records of topic are skipped", topic);
+            producer = nullptr;
+        }
+        _producers.emplace(topic, producer);
+        return producer;
+    }
+
+    replay_result kafka_replayer::replay(kafka_capture_reader &reader)
+    {
+        replay_result result;
+        auto start = std::chrono::steady_clock::now();
+        int64_t first_timestamp = -1;
+        capture_record record;
+        while (_run && reader.next(record))
+        {
+            if (first_timestamp < 0)
+            {
+                first_timestamp = record.timestamp;
+            }
+            if (_speed > 0)
+            {
+                auto offset_us = static_cast<int64_t>(static_cast<double>(record.timestamp - first_timestamp) * 1000.0 / _speed);
+                auto scheduled = start + std::chrono::microseconds(std::max<int64_t>(offset_us, 0));
+                auto now = std::chrono::steady_clock::now();
+                if (scheduled > now)
+                {
+                    std::this_thread::sleep_until(scheduled);
+                }
+                else
+                {
+                    result.max_behind_schedule_ms = std::max<int64_t>(result.max_behind_schedule_ms,
+                                                                      std::chrono::duration_cast<std::chrono::milliseconds>(now - scheduled).count());
+                }
+            }
+            auto producer = get_producer(record.topic);
+            if (!producer)
+            {
+                continue;
+            }
+            result.bytes += record.payload.size();
+            if (record.key.empty())
+            {
+                producer->send(std::move(record.payload));
+            }
+            else
+            {
+                producer->send(std::move(record.payload), record.key);
+            }
+            result.records++;
+        }
+        result.elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        SPDLOG_INFO("Replayed {0} records ({1} bytes) in {2} ms, max {3} ms behind schedule", result.records, result.bytes,
+                    result.elapsed_ms, result.max_behind_schedule_ms);
+        return result;
+    }
+
+    void kafka_replayer::stop()
+    {
+        _run = false;
+    }
+}
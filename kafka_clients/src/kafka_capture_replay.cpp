@@ -0,0 +1,113 @@
+#include "kafka_client.h"
+#include "kafka_capture.h"
+
+#include <csignal>
+#include <chrono>
+#include <stdexcept>
+
+namespace
+{
+    std::atomic<bool> interrupted{false};
+
+    void on_interrupt(int)
+    {
+        interrupted = true;
+    }
+
+    void print_usage()
+    {
+        SPDLOG_INFO("Usage:");
+        SPDLOG_INFO("  kafka_capture_replay capture <broker> <capture file> <duration in sec, 0 until interrupted> <topic> [topic ...]");
+        SPDLOG_INFO("  kafka_capture_replay replay <broker> <capture file> <speed factor, e.g. 1, 10 or max>");
+    }
+
+    int capture(const std::string &broker, const std::string &path, int duration_sec, const std::vector<std::string> &topics)
+    {
+        kafka_clients::kafka_capture_writer writer(path);
+        if (!writer.is_open())
+        {
+            return 1;
+        }
+        kafka_clients::kafka_client client;
+        auto consumer = client.create_consumer(broker, topics, "kafka_capture_replay");
+        if (!consumer->init())
+        {
+            SPDLOG_CRITICAL("kafka consumer initialize error");
+            return 1;
+        }
+        consumer->subscribe();
+        auto end = std::chrono::steady_clock::now() + std::chrono::seconds(duration_sec);
+        while (consumer->is_running() && !interrupted && (duration_sec <= 0 || std::chrono::steady_clock::now() < end))
+        {
+            for (const auto &message : consumer->consume_batch(100, 100))
+            {
+                writer.write(message);
+            }
+        }
+        consumer->stop();
+        writer.flush();
+        SPDLOG_INFO("Captured {0} records to {1}", writer.get_record_count(), path);
+        return 0;
+    }
+
+    int replay(const std::string &broker, const std::string &path, double speed)
+    {
+        kafka_clients::kafka_capture_reader reader(path);
+        if (!reader.is_open())
+        {
+            return 1;
+        }
+        kafka_clients::kafka_replayer replayer(broker, speed);
+        std::thread stop_t([&replayer]()
+                           {
+            while (!interrupted)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            replayer.stop(); });
+        auto result = replayer.replay(reader);
+        SPDLOG_INFO("Throughput {0} records/s", result.elapsed_ms > 0 ? result.records * 1000 / result.elapsed_ms : result.records);
+        interrupted = true;
+        stop_t.join();
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::signal(SIGINT, on_interrupt);
+    std::signal(SIGTERM, on_interrupt);
+    bool is_capture = argc >= 6 && std::string(argv[1]) == "capture";
+    bool is_replay = argc == 5 && std::string(argv[1]) == "replay";
+    int duration_sec = 0;
+    double speed = 0;
+    try
+    {
+        if (is_capture)
+        {
+            duration_sec = std::stoi(argv[4]);
+        }
+        else if (is_replay && std::string(argv[4]) != "max")
+        {
+            speed = std::stod(argv[4]);
+        }
+    }
+    catch (const std::logic_error &e)
+    {
+        // std::invalid_argument or std::out_of_range
+        SPDLOG_CRITICAL("Invalid number argument {0}: {1}", argv[4], e.what());
+        print_usage();
+        return 1;
+    }
+    if (is_capture && duration_sec >= 0)
+    {
+        std::vector<std::string> topics(argv + 5, argv + argc);
+        return capture(argv[2], argv[3], duration_sec, topics);
+    }
+    if (is_replay && speed >= 0)
+    {
+        return replay(argv[2], argv[3], speed);
+    }
+    print_usage();
+    return 1;
+}
@@ -2,6 +2,15 @@
 
 namespace kafka_clients
 {
+    kafka_client::kafka_client(kafka_transport transport) : _transport(transport)
+    {
+    }
+
+    bool kafka_client::use_in_process(const std::string &broker_str) const
+    {
+        return _transport == kafka_transport::IN_PROCESS || broker_str.rfind(IN_PROCESS_BROKER, 0) == 0;
+    }
+
     std::shared_ptr<kafka_clients::kafka_consumer_worker> kafka_client::create_consumer(const std::string &bootstrap_server, const std::string &topic_str,
                                                                                         const std::string &group_id_str) const
     {
@@ -9,6 +18,10 @@ namespace kafka_clients
         {
             int partition = 0;
             int64_t cur_offset = RdKafka::Topic::OFFSET_END;
+            if (use_in_process(bootstrap_server))
+            {
+                return std::make_shared<kafka_clients::in_process_consumer_worker>(topic_str, group_id_str, cur_offset);
+            }
             auto consumer_ptr = std::make_shared<kafka_clients::kafka_consumer_worker>(bootstrap_server, topic_str, group_id_str, cur_offset, partition);
             return consumer_ptr;
         }
@@ -19,11 +32,36 @@ namespace kafka_clients
         }
     }
 
+    std::shared_ptr<kafka_clients::kafka_consumer_worker> kafka_client::create_consumer(const std::string &bootstrap_server, const std::vector<std::string> &topics,
+                                                                                        const std::string &group_id_str) const
+    {
+        try
+        {
+            int partition = 0;
+            int64_t cur_offset = RdKafka::Topic::OFFSET_END;
+            if (use_in_process(bootstrap_server))
+            {
+                return std::make_shared<kafka_clients::in_process_consumer_worker>(topics, group_id_str, cur_offset);
+            }
+            auto consumer_ptr = std::make_shared<kafka_clients::kafka_consumer_worker>(bootstrap_server, topics, group_id_str, cur_offset, partition);
+            return consumer_ptr;
+        }
+        catch (const std::runtime_error &e)
+        {
+            SPDLOG_CRITICAL("Create consumer failure: {0}", e.what());
+            exit(1);
+        }
+    }
+
     std::shared_ptr<kafka_clients::kafka_producer_worker> kafka_client::create_producer(const std::string &bootstrap_server, const std::string &topic_str) const
     {
         try
         {
             int partition = 0;
+            if (use_in_process(bootstrap_server))
+            {
+                return std::make_shared<kafka_clients::in_process_producer_worker>(topic_str);
+            }
             auto producer_ptr = std::make_shared<kafka_clients::kafka_producer_worker>(bootstrap_server, topic_str, partition);
             return producer_ptr;
         }
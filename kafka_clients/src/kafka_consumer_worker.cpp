@@ -1,13 +1,25 @@
 #include "kafka_consumer_worker.h"
+#include <algorithm>
+#include <chrono>
 
 namespace kafka_clients
 {
 
     kafka_consumer_worker::kafka_consumer_worker(const std::string &broker_str, const std::string &topic_str,
                                                  const std::string &group_id_str, int64_t cur_offset, int32_t partition)
-        :_topics_str(topic_str), _broker_str(broker_str), _group_id_str(group_id_str), _cur_offet(cur_offset),
+        : kafka_consumer_worker(broker_str, std::vector<std::string>{topic_str}, group_id_str, cur_offset, partition)
+    {
+    }
+
+    kafka_consumer_worker::kafka_consumer_worker(const std::string &broker_str, const std::vector<std::string> &topics,
+                                                 const std::string &group_id_str, int64_t cur_offset, int32_t partition)
+        : _topics(topics), _broker_str(broker_str), _group_id_str(group_id_str), _cur_offet(cur_offset),
           _partition(partition)
     {
+        for (const auto &topic : _topics)
+        {
+            _topics_str += _topics_str.empty() ? topic : "," + topic;
+        }
     }
 
     bool kafka_consumer_worker::init()
@@ -37,6 +49,12 @@ namespace kafka_clients
             return false;
         }
 
+        if (conf->set(STATISTICS_INTERVAL, std::to_string(_statistics_interval_ms), errstr) != RdKafka::Conf::CONF_OK)
+        {
+            SPDLOG_CRITICAL("RDKafka conf set statistics interval failed: {0} ", errstr.c_str());
+            return false;
+        }
+
         if (conf->set(ENABLE_PARTITION_END_OF, "true", errstr) != RdKafka::Conf::CONF_OK)
         {
             SPDLOG_CRITICAL("RDKafka conf set partition end of failed: {0} ", errstr.c_str());
@@ -50,6 +68,12 @@ namespace kafka_clients
             return false;
         }
 
+        if (!_group_instance_id_str.empty() && conf->set(GROUP_INSTANCE_ID, _group_instance_id_str, errstr) != RdKafka::Conf::CONF_OK)
+        {
+            SPDLOG_CRITICAL("RDKafka conf set group instance id failed:  {0} ", errstr.c_str());
+            return false;
+        }
+
         if (conf->set(MAX_PARTITION_FETCH_SIZE, STR_FETCH_NUM, errstr) != RdKafka::Conf::CONF_OK)
         {
             SPDLOG_CRITICAL("RDKafka cof set max.partition failed:  {0} ", errstr.c_str());
@@ -74,7 +98,7 @@ namespace kafka_clients
             return false;
         }
 
-        _topic = RdKafka::Topic::create(_consumer, _topics_str, tconf, errstr);
+        _topic = RdKafka::Topic::create(_consumer, _topics.empty() ? _topics_str : _topics.front(), tconf, errstr);
         if (!_topic)
         {
             SPDLOG_CRITICAL("RDKafka create topic failed:  {0}", errstr.c_str());
@@ -86,6 +110,58 @@ namespace kafka_clients
         return true;
     }
 
+    void kafka_consumer_worker::set_statistics_interval(int interval_ms)
+    {
+        _statistics_interval_ms = interval_ms;
+    }
+
+    kafka_statistics kafka_consumer_worker::get_statistics() const
+    {
+        return _consumer_event_cb.statistics.get();
+    }
+
+    void kafka_consumer_worker::set_group_instance_id(const std::string &group_instance_id)
+    {
+        _group_instance_id_str = group_instance_id;
+    }
+
+    uint64_t kafka_consumer_worker::get_revoked_count() const
+    {
+        return _consumer_rebalance_cb.revoked_cnt;
+    }
+
+    void kafka_consumer_worker::set_seek_to_latest(bool seek_to_latest)
+    {
+        _consumer_rebalance_cb.seek_to_latest = seek_to_latest;
+    }
+
+    void kafka_consumer_worker::set_max_message_age(int max_age_ms)
+    {
+        _max_message_age_ms = max_age_ms;
+    }
+
+    uint64_t kafka_consumer_worker::get_stale_dropped_count() const
+    {
+        return _stale_dropped;
+    }
+
+    bool kafka_consumer_worker::drop_if_stale(const kafka_message &message)
+    {
+        int max_age_ms = _max_message_age_ms;
+        if (max_age_ms <= 0 || message.empty() || message.timestamp() < 0)
+        {
+            return false;
+        }
+        int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        if (now_ms - message.timestamp() <= max_age_ms)
+        {
+            return false;
+        }
+        _stale_dropped++;
+        SPDLOG_DEBUG("Dropped stale message from topic {0} at offset {1}, age {2} ms", _topics_str, message.offset(), now_ms - message.timestamp());
+        return true;
+    }
+
     void kafka_consumer_worker::stop()
     {
         _run = false;
@@ -95,26 +171,69 @@ namespace kafka_clients
 
     void kafka_consumer_worker::subscribe()
     {
-        std::vector<std::string> _topics_str_list;
-        _topics_str_list.push_back(_topics_str);
-        RdKafka::ErrorCode err = _consumer->subscribe(_topics_str_list);
+        RdKafka::ErrorCode err = _consumer->subscribe(_topics);
         if (err)
         {
-            SPDLOG_CRITICAL(" {0} Failed to subscribe to   {1} topics: {2} ", _consumer->name(), _topics_str_list.size(), RdKafka::err2str(err).c_str());
+            SPDLOG_CRITICAL(" {0} Failed to subscribe to   {1} topics: {2} ", _consumer->name(), _topics.size(), RdKafka::err2str(err).c_str());
             _run = false;
             exit(1);
         } else {
-            SPDLOG_INFO("{0} Successfully to subscribe to   {1} topics: {2} ", _consumer->name(), _topics_str_list.size(), RdKafka::err2str(err).c_str());
+            SPDLOG_INFO("{0} Successfully to subscribe to   {1} topics: {2} ", _consumer->name(), _topics.size(), _topics_str);
             _run = true;
         }
     }
 
     const char *kafka_consumer_worker::consume(int timeout_ms)
     {
-        RdKafka::Message *msg = nullptr;
-        msg = _consumer->consume(timeout_ms);
-        const char *msg_str = msg_consume(msg, nullptr);
-        return msg_str;
+        kafka_message message = consume_message(timeout_ms);
+        _last_payload.assign(message.payload());
+        return _last_payload.c_str();
+    }
+
+    kafka_message kafka_consumer_worker::consume_message(int timeout_ms)
+    {
+        RdKafka::Message *msg = _consumer->consume(timeout_ms);
+        kafka_message message(msg);
+        if (!msg_consume(msg) || drop_if_stale(message))
+        {
+            return kafka_message();
+        }
+        return message;
+    }
+
+    std::vector<kafka_message> kafka_consumer_worker::consume_batch(size_t max_messages, int timeout_ms)
+    {
+        std::vector<kafka_message> batch;
+        batch.reserve(max_messages);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        int wait_ms = timeout_ms;
+        while (batch.size() < max_messages)
+        {
+            RdKafka::Message *msg = _consumer->consume(wait_ms);
+            kafka_message message(msg);
+            if (!msg_consume(msg))
+            {
+                // The end of one partition does not end the batch, other subscribed partitions may have messages.
+                // Timeout or error ends the batch.
+                if (msg->err() == RdKafka::ERR__PARTITION_EOF && _run)
+                {
+                    if (batch.empty())
+                    {
+                        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                        wait_ms = static_cast<int>(std::max<int64_t>(remaining, 0));
+                    }
+                    continue;
+                }
+                break;
+            }
+            if (!message.empty() && !drop_if_stale(message))
+            {
+                batch.push_back(std::move(message));
+            }
+            // Only wait for the first message. Drain the rest without blocking.
+            wait_ms = 0;
+        }
+        return batch;
     }
 
     bool kafka_consumer_worker::is_running() const
@@ -127,18 +246,18 @@ namespace kafka_clients
                      (_broker_str.empty() ? "UNKNOWN" : _broker_str), (_topics_str.empty() ? "UNKNOWN" : _topics_str), _partition, (_group_id_str.empty() ? "UNKNOWN" : _group_id_str));
     }
 
-    const char *kafka_consumer_worker::msg_consume(RdKafka::Message *message, void *opaque)
+    bool kafka_consumer_worker::msg_consume(const RdKafka::Message *message)
     {
-        const char *return_msg_str = "";
+        bool has_payload = false;
         switch (message->err())
         {
         case RdKafka::ERR__TIMED_OUT:
             break;
         case RdKafka::ERR_NO_ERROR:
             SPDLOG_TRACE(" {0} Read message at offset {1} ", _consumer->name(), message->offset());
-            SPDLOG_TRACE(" {0} Message Consumed: {1}   bytes ):  {2}", _consumer->name(), static_cast<int>(message->len()), static_cast<const char *>(message->payload()));
+            SPDLOG_TRACE(" {0} Message Consumed: {1}   bytes ):  {2}", _consumer->name(), static_cast<int>(message->len()), std::string_view(static_cast<const char *>(message->payload()), message->len()));
             _last_offset = message->offset();
-            return_msg_str = static_cast<const char *>(message->payload());
+            has_payload = true;
             break;
         case RdKafka::ERR__PARTITION_EOF:
             SPDLOG_TRACE("{0} Reached the end of the queue, offset : {1}", _consumer->name(), _last_offset);
@@ -155,6 +274,6 @@ namespace kafka_clients
             stop();
             break;
         }
-        return return_msg_str;
+        return has_payload;
     }
 }
\ No newline at end of file
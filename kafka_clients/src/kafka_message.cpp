@@ -0,0 +1,101 @@
+#include "kafka_message.h"
+
+#include <librdkafka/rdkafka.h>
+
+namespace kafka_clients
+{
+    kafka_message::kafka_message(RdKafka::Message *message) : _message(message)
+    {
+        // RdKafka::Message::topic_name() returns a copy. The message holds a reference to its topic handle, so the
+        // name of the handle outlives the view.
+        if (_message)
+        {
+            auto c_message = static_cast<const rd_kafka_message_t *>(_message->c_ptr());
+            if (c_message && c_message->rkt)
+            {
+                _topic = rd_kafka_topic_name(c_message->rkt);
+            }
+        }
+    }
+
+    kafka_message::kafka_message(std::shared_ptr<const std::string> payload, int64_t offset, int64_t timestamp, std::string_view topic)
+        : _shared_payload(std::move(payload)), _shared_offset(offset), _shared_timestamp(timestamp), _topic(topic)
+    {
+    }
+
+    bool kafka_message::empty() const
+    {
+        if (_shared_payload)
+        {
+            return _shared_payload->empty();
+        }
+        return !_message || _message->payload() == nullptr || _message->len() == 0;
+    }
+
+    std::string_view kafka_message::payload() const
+    {
+        if (empty())
+        {
+            return std::string_view();
+        }
+        if (_shared_payload)
+        {
+            return std::string_view(*_shared_payload);
+        }
+        return std::string_view(static_cast<const char *>(_message->payload()), _message->len());
+    }
+
+    int64_t kafka_message::offset() const
+    {
+        if (_shared_payload)
+        {
+            return _shared_offset;
+        }
+        if (!_message)
+        {
+            return RdKafka::Topic::OFFSET_INVALID;
+        }
+        return _message->offset();
+    }
+
+    int64_t kafka_message::timestamp() const
+    {
+        if (_shared_payload)
+        {
+            return _shared_timestamp;
+        }
+        if (!_message || _message->timestamp().type == RdKafka::MessageTimestamp::MSG_TIMESTAMP_NOT_AVAILABLE)
+        {
+            return -1;
+        }
+        return _message->timestamp().timestamp;
+    }
+
+    int32_t kafka_message::partition() const
+    {
+        if (_shared_payload)
+        {
+            // In-process topics have a single partition
+            return 0;
+        }
+        if (!_message)
+        {
+            return RdKafka::Topic::PARTITION_UA;
+        }
+        return _message->partition();
+    }
+
+    std::string_view kafka_message::key() const
+    {
+        if (!_message || !_message->key())
+        {
+            return std::string_view();
+        }
+        return std::string_view(*_message->key());
+    }
+
+    std::string_view kafka_message::topic() const
+    {
+        return _topic;
+    }
+}
@@ -1,5 +1,6 @@
-
 #include "kafka_producer_worker.h"
+#include <algorithm>
+#include <string_view>
 namespace kafka_clients
 {
     kafka_producer_worker::kafka_producer_worker(const std::string &brokers, const std::string &topics, int partition)
@@ -40,6 +41,12 @@ namespace kafka_clients
             return false;
         }
 
+        if (conf->set(STATISTICS_INTERVAL, std::to_string(_statistics_interval_ms), errstr) != RdKafka::Conf::CONF_OK)
+        {
+            SPDLOG_CRITICAL("RdKafka conf set statistics interval failed: {0} ", errstr.c_str());
+            return false;
+        }
+
         // create producer using accumulated global configuration.
         _producer = RdKafka::Producer::create(conf, errstr);
         if (!_producer)
@@ -51,6 +58,12 @@ namespace kafka_clients
 
         SPDLOG_INFO("created producer:  {:>8} ", _producer->name());
 
+        if (tconf->set(PARTITIONER, PARTITIONER_MURMUR2, errstr) != RdKafka::Conf::CONF_OK)
+        {
+            SPDLOG_CRITICAL("RdKafka conf set partitioner failed: {0} ", errstr.c_str());
+            return false;
+        }
+
         // Create topic handle
         _topic = RdKafka::Topic::create(_producer, _topics_str, tconf, errstr);
         if (!_topic)
@@ -60,62 +73,180 @@ namespace kafka_clients
             return false;
         }
         delete tconf;
+        if (_async)
+        {
+            _poll_thread = std::thread(&kafka_producer_worker::poll_loop, this);
+        }
         printCurrConf();
         return true;
     }
 
-    bool kafka_producer_worker::is_running() const {
-        return _run;
+    void kafka_producer_worker::set_async(bool async, int poll_interval_ms)
+    {
+        _async = async;
+        _poll_interval_ms = poll_interval_ms;
     }
 
-    void kafka_producer_worker::send(const std::string &msg)
+    void kafka_producer_worker::set_queue_full_policy(queue_full_policy policy, int block_timeout_ms)
     {
+        _queue_full_policy = policy;
+        _queue_full_timeout_ms = block_timeout_ms;
+    }
 
-        if (!_run)
-            return;
+    producer_metrics kafka_producer_worker::get_metrics() const
+    {
+        producer_metrics metrics;
+        metrics.produced = _produced;
+        metrics.delivered = _producer_delivery_report_cb.delivered;
+        metrics.failed = _producer_delivery_report_cb.failed;
+        metrics.dropped = _dropped + _producer_delivery_report_cb.purged;
+        metrics.last_delivery_latency_us = _producer_delivery_report_cb.last_latency_us;
+        metrics.max_delivery_latency_us = _producer_delivery_report_cb.max_latency_us;
+        if (metrics.delivered > 0)
+        {
+            metrics.avg_delivery_latency_us = static_cast<double>(_producer_delivery_report_cb.total_latency_us) / static_cast<double>(metrics.delivered);
+        }
+        if (_producer)
+        {
+            metrics.queue_depth = _producer->outq_len();
+        }
+        return metrics;
+    }
 
-        if (msg.empty())
+    void kafka_producer_worker::set_statistics_interval(int interval_ms)
+    {
+        _statistics_interval_ms = interval_ms;
+    }
+
+    kafka_statistics kafka_producer_worker::get_statistics() const
+    {
+        return _producer_event_cb.statistics.get();
+    }
+
+    void kafka_producer_worker::poll_loop()
+    {
+        SPDLOG_INFO("Starting producer poll thread for topic {0}", _topics_str);
+        while (_run)
         {
-            _producer->poll(0);
-            return;
+            _producer->poll(_poll_interval_ms);
         }
+        SPDLOG_INFO("Stopped producer poll thread for topic {0}", _topics_str);
+    }
 
-        // produce messages
+    bool kafka_producer_worker::handle_queue_full(const std::chrono::steady_clock::time_point &deadline)
+    {
+        switch (_queue_full_policy)
+        {
+        case queue_full_policy::DROP_NEWEST:
+            return false;
+        case queue_full_policy::DROP_QUEUED:
+            /* All messages still waiting in the local queue are superseded by the new message.
+             * Purged messages are reported to the delivery report callback with ERR__PURGE_QUEUE. */
+            _producer->purge(RdKafka::Producer::PURGE_QUEUE | RdKafka::Producer::PURGE_NON_BLOCKING);
+            return true;
+        default:
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return false;
+            }
+            int remaining_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count());
+            if (_async)
+            {
+                /* Poll thread is serving delivery reports, wait for it to free queue space. */
+                std::this_thread::sleep_for(std::chrono::milliseconds(std::min(remaining_ms, 1)));
+            }
+            else
+            {
+                /* If the internal queue is full, wait for
+                 * messages to be delivered and then retry.
+                 * The internal queue represents both
+                 * messages to be sent and messages that have
+                 * been sent or failed, awaiting their
+                 * delivery report callback to be called.
+                 *
+                 * The internal queue is limited by the
+                 * configuration property
+                 * queue.buffering.max.messages */
+                _producer->poll(remaining_ms);
+            }
+            return true;
+        }
+        }
+    }
+
+    bool kafka_producer_worker::is_running() const {
+        return _run;
+    }
+
+    bool kafka_producer_worker::produce(char *payload, size_t len, int msgflags, void *msg_opaque, const std::string *key)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_queue_full_timeout_ms);
         while (true)
         {
             RdKafka::ErrorCode resp = _producer->produce(_topic,
-                                                         _partition,
-                                                         RdKafka::Producer::RK_MSG_COPY,
-                                                         const_cast<char *>(msg.c_str()),
-                                                         msg.size(),
-                                                         NULL,
-                                                         NULL);
-            if (resp != RdKafka::ERR_NO_ERROR)
+                                                         key ? RdKafka::Topic::PARTITION_UA : _partition,
+                                                         msgflags,
+                                                         payload,
+                                                         len,
+                                                         key,
+                                                         msg_opaque);
+            if (resp == RdKafka::ERR_NO_ERROR)
             {
-                SPDLOG_CRITICAL(" {0} Produce failed:  {1} ", _producer->name(), RdKafka::err2str(resp));
-                if (resp == RdKafka::ERR__QUEUE_FULL)
-                {
-                    /* If the internal queue is full, wait for
-                     * messages to be delivered and then retry.
-                     * The internal queue represents both
-                     * messages to be sent and messages that have
-                     * been sent or failed, awaiting their
-                     * delivery report callback to be called.
-                     *
-                     * The internal queue is limited by the
-                     * configuration property
-                     * queue.buffering.max.messages */
-                    _producer->poll(1000 /*block for max 1000ms*/);
-                    continue;
-                }
+                _produced++;
+                // Arguments are evaluated at any runtime log level, log a view of the payload instead of a copy
+                SPDLOG_TRACE(" {0} Produced message ( {1}  bytes ) , message content:  {2}", _topics_str, len, std::string_view(payload, len));
+                return true;
+            }
+            if (resp == RdKafka::ERR__QUEUE_FULL && handle_queue_full(deadline))
+            {
+                continue;
+            }
+            if (resp == RdKafka::ERR__QUEUE_FULL)
+            {
+                _dropped++;
+                SPDLOG_WARN(" {0} Producer queue full, dropped message ( {1} bytes )", _producer->name(), len);
             }
             else
             {
-                SPDLOG_TRACE(" {0} Produced message ( {1}  bytes ) , message content:  {2}", _producer->name(), msg.size(), msg.c_str());
+                SPDLOG_CRITICAL(" {0} Produce failed:  {1} ", _producer->name(), RdKafka::err2str(resp));
             }
-
             // break the loop regardless of sucessfully sent or failed
-            break;
+            return false;
+        }
+    }
+
+    void kafka_producer_worker::send(const std::string &msg)
+    {
+        send_copy(msg, nullptr);
+    }
+
+    void kafka_producer_worker::send(const std::string &msg, const std::string &key)
+    {
+        send_copy(msg, &key);
+    }
+
+    void kafka_producer_worker::send(std::string &&msg)
+    {
+        send_owned(std::move(msg), nullptr);
+    }
+
+    void kafka_producer_worker::send(std::string &&msg, const std::string &key)
+    {
+        send_owned(std::move(msg), &key);
+    }
+
+    void kafka_producer_worker::send_copy(const std::string &msg, const std::string *key)
+    {
+
+        if (!_run)
+            return;
+
+        if (!msg.empty())
+        {
+            // produce messages
+            produce(const_cast<char *>(msg.c_str()), msg.size(), RdKafka::Producer::RK_MSG_COPY, NULL, key);
         }
 
         /* A producer application should continually serve
@@ -128,7 +259,33 @@ namespace kafka_clients
          * to make sure previously produced messages have their
          * delivery report callback served (and any other callbacks
          * you register). */
-        _producer->poll(0);
+        if (!_async)
+        {
+            _producer->poll(0);
+        }
+    }
+
+    void kafka_producer_worker::send_owned(std::string &&msg, const std::string *key)
+    {
+        if (!_run)
+            return;
+
+        if (!msg.empty())
+        {
+            /* Hand the payload buffer to librdkafka without RK_MSG_COPY. The owning string travels as message
+             * opaque and is released by the delivery report callback. RK_MSG_FREE is not used since the buffer
+             * is owned by std::string and not allocated with malloc. */
+            auto owned = std::make_unique<std::string>(std::move(msg));
+            if (produce(owned->data(), owned->size(), 0, owned.get(), key))
+            {
+                owned.release();
+            }
+        }
+
+        if (!_async)
+        {
+            _producer->poll(0);
+        }
     }
 
     void kafka_producer_worker::stop()
@@ -137,6 +294,10 @@ namespace kafka_clients
          * flush() is an abstraction over poll() which
          * waits for all messages to be delivered. */
         _run = false;
+        if (_poll_thread.joinable())
+        {
+            _poll_thread.join();
+        }
         SPDLOG_CRITICAL("Stopping producer client.. ");
         SPDLOG_CRITICAL("Flushing final messages... ");
         try
@@ -155,6 +316,15 @@ namespace kafka_clients
         }
     }
 
+    kafka_producer_worker::~kafka_producer_worker()
+    {
+        _run = false;
+        if (_poll_thread.joinable())
+        {
+            _poll_thread.join();
+        }
+    }
+
     void kafka_producer_worker::printCurrConf()
     {
         SPDLOG_INFO("Producer connect to bootstrap_server: {0}, topic: {1} ,partition: {2} ",
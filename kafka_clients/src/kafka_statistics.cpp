@@ -0,0 +1,132 @@
+#include "kafka_statistics.h"
+#include <algorithm>
+
+namespace kafka_clients
+{
+    namespace
+    {
+        int64_t get_int64(const rapidjson::Value &obj, const char *key)
+        {
+            auto itr = obj.FindMember(key);
+            if (itr != obj.MemberEnd() && itr->value.IsInt64())
+            {
+                return itr->value.GetInt64();
+            }
+            return 0;
+        }
+    }
+
+    int64_t kafka_statistics::consumer_lag(const std::string &topic) const
+    {
+        int64_t lag = -1;
+        for (const auto &part : partitions)
+        {
+            if (part.topic == topic && part.consumer_lag >= 0)
+            {
+                lag = std::max<int64_t>(lag, 0) + part.consumer_lag;
+            }
+        }
+        return lag;
+    }
+
+    int64_t kafka_statistics::max_rtt_p99_us() const
+    {
+        int64_t rtt = 0;
+        for (const auto &broker : brokers)
+        {
+            rtt = std::max(rtt, broker.rtt_p99_us);
+        }
+        return rtt;
+    }
+
+    bool parse_statistics(const std::string &json, kafka_statistics &stats)
+    {
+        rapidjson::Document doc;
+        if (doc.Parse(json.c_str(), json.size()).HasParseError() || !doc.IsObject())
+        {
+            SPDLOG_ERROR("Failed to parse kafka statistics!");
+            return false;
+        }
+        stats.timestamp_us = get_int64(doc, "ts");
+        stats.rxmsgs = get_int64(doc, "rxmsgs");
+        stats.txmsgs = get_int64(doc, "txmsgs");
+        stats.outq_msgs = get_int64(doc, "msg_cnt");
+        stats.brokers.clear();
+        stats.partitions.clear();
+
+        if (doc.HasMember("brokers") && doc["brokers"].IsObject())
+        {
+            for (const auto &broker_itr : doc["brokers"].GetObject())
+            {
+                const auto &broker = broker_itr.value;
+                broker_statistics broker_stats;
+                broker_stats.name = broker_itr.name.GetString();
+                broker_stats.node_id = static_cast<int32_t>(get_int64(broker, "nodeid"));
+                broker_stats.outbuf_cnt = get_int64(broker, "outbuf_cnt");
+                if (broker.HasMember("rtt") && broker["rtt"].IsObject())
+                {
+                    broker_stats.rtt_avg_us = get_int64(broker["rtt"], "avg");
+                    broker_stats.rtt_p99_us = get_int64(broker["rtt"], "p99");
+                }
+                stats.brokers.push_back(broker_stats);
+            }
+        }
+
+        if (doc.HasMember("topics") && doc["topics"].IsObject())
+        {
+            for (const auto &topic_itr : doc["topics"].GetObject())
+            {
+                const auto &topic = topic_itr.value;
+                if (!topic.HasMember("partitions") || !topic["partitions"].IsObject())
+                {
+                    continue;
+                }
+                for (const auto &part_itr : topic["partitions"].GetObject())
+                {
+                    const auto &part = part_itr.value;
+                    auto partition = static_cast<int32_t>(get_int64(part, "partition"));
+                    // Partition -1 is the internal queue for messages not yet assigned to a partition
+                    if (partition < 0)
+                    {
+                        continue;
+                    }
+                    partition_statistics part_stats;
+                    part_stats.topic = topic_itr.name.GetString();
+                    part_stats.partition = partition;
+                    part_stats.consumer_lag = part.HasMember("consumer_lag") ? get_int64(part, "consumer_lag") : -1;
+                    part_stats.rxmsgs = get_int64(part, "rxmsgs");
+                    part_stats.txmsgs = get_int64(part, "txmsgs");
+                    part_stats.outq_msgs = get_int64(part, "msgq_cnt") + get_int64(part, "xmit_msgq_cnt");
+                    stats.partitions.push_back(part_stats);
+                }
+            }
+        }
+        return true;
+    }
+
+    void kafka_statistics_store::update(const std::string &json)
+    {
+        kafka_statistics stats;
+        if (!parse_statistics(json, stats))
+        {
+            return;
+        }
+        std::unique_lock<std::mutex> lck(_stats_mtx);
+        stats.throttle_count = _stats.throttle_count;
+        stats.last_throttle_time_ms = _stats.last_throttle_time_ms;
+        _stats = std::move(stats);
+    }
+
+    void kafka_statistics_store::throttled(int throttle_time_ms)
+    {
+        std::unique_lock<std::mutex> lck(_stats_mtx);
+        _stats.throttle_count++;
+        _stats.last_throttle_time_ms = throttle_time_ms;
+    }
+
+    kafka_statistics kafka_statistics_store::get() const
+    {
+        std::unique_lock<std::mutex> lck(_stats_mtx);
+        return _stats;
+    }
+}
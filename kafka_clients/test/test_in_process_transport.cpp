@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+#include "kafka_client.h"
+
+TEST(test_in_process_transport, produce_consume)
+{
+    kafka_clients::kafka_client client(kafka_clients::kafka_transport::IN_PROCESS);
+    auto producer = client.create_producer("", "in_process_test");
+    auto consumer = client.create_consumer("", "in_process_test", "test_group");
+    ASSERT_TRUE(producer->init());
+    ASSERT_TRUE(consumer->init());
+    consumer->subscribe();
+    ASSERT_TRUE(consumer->is_running());
+
+    // Nothing produced yet
+    EXPECT_TRUE(consumer->consume_message(10).empty());
+
+    producer->send(std::string("message 1"));
+    std::string msg = "message 2";
+    producer->send(msg);
+    auto message = consumer->consume_message(10);
+    ASSERT_FALSE(message.empty());
+    EXPECT_EQ("message 1", message.payload());
+    EXPECT_EQ(0, message.offset());
+    EXPECT_GT(message.timestamp(), 0);
+    EXPECT_EQ("message 2", std::string(consumer->consume(10)));
+    EXPECT_EQ(2, producer->get_metrics().produced);
+
+    producer->stop();
+    consumer->stop();
+    EXPECT_FALSE(producer->is_running());
+    EXPECT_FALSE(consumer->is_running());
+}
+
+TEST(test_in_process_transport, consume_batch)
+{
+    // Broker string prefix selects the in-process transport
+    kafka_clients::kafka_client client;
+    auto producer = client.create_producer(kafka_clients::IN_PROCESS_BROKER, "in_process_batch_test");
+    auto consumer = client.create_consumer(kafka_clients::IN_PROCESS_BROKER, "in_process_batch_test", "test_group");
+    ASSERT_TRUE(producer->init());
+    ASSERT_TRUE(consumer->init());
+    consumer->subscribe();
+    for (int i = 0; i < 5; i++)
+    {
+        producer->send(std::to_string(i));
+    }
+    auto batch = consumer->consume_batch(3, 10);
+    ASSERT_EQ(3, batch.size());
+    EXPECT_EQ("0", batch.front().payload());
+    batch = consumer->consume_batch(10, 10);
+    ASSERT_EQ(2, batch.size());
+    EXPECT_EQ("4", batch.back().payload());
+    EXPECT_TRUE(consumer->consume_batch(10, 0).empty());
+}
+
+TEST(test_in_process_transport, topic_overwrites_oldest)
+{
+    kafka_clients::in_process_topic topic("overwrite_test", 4);
+    for (int i = 0; i < 6; i++)
+    {
+        topic.produce(std::make_shared<const std::string>(std::to_string(i)));
+    }
+    EXPECT_EQ(6, topic.end_offset());
+    EXPECT_EQ(2, topic.begin_offset());
+    // Consumer behind the ring skips to the oldest retained record
+    int64_t offset = 0;
+    kafka_clients::in_process_record record;
+    ASSERT_TRUE(topic.read(offset, record));
+    EXPECT_EQ(2, record.offset);
+    EXPECT_EQ("2", *record.payload);
+    EXPECT_EQ(3, offset);
+    offset = 6;
+    EXPECT_FALSE(topic.read(offset, record));
+}
+
+TEST(test_in_process_transport, topic_capacity)
+{
+    EXPECT_THROW(kafka_clients::in_process_topic("capacity_test", 1), std::invalid_argument);
+    EXPECT_THROW(kafka_clients::in_process_broker::set_topic_capacity(0), std::invalid_argument);
+    kafka_clients::in_process_topic topic("capacity_test", 2);
+    for (int i = 0; i < 3; i++)
+    {
+        topic.produce(std::make_shared<const std::string>(std::to_string(i)));
+    }
+    int64_t offset = 0;
+    kafka_clients::in_process_record record;
+    ASSERT_TRUE(topic.read(offset, record));
+    EXPECT_EQ(1, record.offset);
+    EXPECT_EQ("1", *record.payload);
+}
+
+TEST(test_in_process_transport, consumer_lag)
+{
+    kafka_clients::kafka_client client(kafka_clients::kafka_transport::IN_PROCESS);
+    auto producer = client.create_producer("", "in_process_lag_test");
+    auto consumer = client.create_consumer("", "in_process_lag_test", "test_group");
+    ASSERT_TRUE(producer->init());
+    ASSERT_TRUE(consumer->init());
+    consumer->subscribe();
+    producer->send(std::string("message 1"));
+    producer->send(std::string("message 2"));
+    auto stats = consumer->get_statistics();
+    EXPECT_EQ(2, stats.consumer_lag("in_process_lag_test"));
+    consumer->consume_message(10);
+    stats = consumer->get_statistics();
+    EXPECT_EQ(1, stats.consumer_lag("in_process_lag_test"));
+    EXPECT_EQ(1, stats.rxmsgs);
+    EXPECT_EQ(2, producer->get_statistics().txmsgs);
+}
+
+TEST(test_in_process_transport, drop_stale_messages)
+{
+    kafka_clients::kafka_client client(kafka_clients::kafka_transport::IN_PROCESS);
+    auto producer = client.create_producer("", "in_process_stale_test");
+    auto consumer = client.create_consumer("", "in_process_stale_test", "test_group");
+    ASSERT_TRUE(producer->init());
+    ASSERT_TRUE(consumer->init());
+    consumer->set_max_message_age(20);
+    consumer->subscribe();
+    producer->send(std::string("stale message"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    producer->send(std::string("fresh message"));
+    auto batch = consumer->consume_batch(10, 10);
+    ASSERT_EQ(1, batch.size());
+    EXPECT_EQ("fresh message", batch.front().payload());
+    EXPECT_EQ(1, consumer->get_stale_dropped_count());
+}
+
+TEST(test_in_process_transport, multi_topic_consumer)
+{
+    kafka_clients::kafka_client client(kafka_clients::kafka_transport::IN_PROCESS);
+    auto bsm_producer = client.create_producer("", "in_process_bsm_test");
+    auto mp_producer = client.create_producer("", "in_process_mp_test");
+    std::vector<std::string> topics = {"in_process_bsm_test", "in_process_mp_test"};
+    auto consumer = client.create_consumer("", topics, "test_group");
+    ASSERT_TRUE(bsm_producer->init());
+    ASSERT_TRUE(mp_producer->init());
+    ASSERT_TRUE(consumer->init());
+    consumer->subscribe();
+    bsm_producer->send(std::string("bsm"));
+    mp_producer->send(std::string("mp"));
+    auto batch = consumer->consume_batch(10, 10);
+    ASSERT_EQ(2, batch.size());
+    for (const auto &message : batch)
+    {
+        if (message.topic() == "in_process_bsm_test")
+        {
+            EXPECT_EQ("bsm", message.payload());
+        }
+        else
+        {
+            EXPECT_EQ("in_process_mp_test", message.topic());
+            EXPECT_EQ("mp", message.payload());
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "kafka_capture.h"
+#include "kafka_client.h"
+
+#include <cstdio>
+
+namespace
+{
+    void write_capture(const std::string &path, const std::string &topic)
+    {
+        kafka_clients::kafka_capture_writer writer(path);
+        ASSERT_TRUE(writer.is_open());
+        for (int i = 0; i < 3; i++)
+        {
+            kafka_clients::capture_record record;
+            record.timestamp = 1000 + i * 100;
+            record.topic = topic;
+            record.key = i == 0 ? "" : "vehicle_" + std::to_string(i);
+            record.payload = "payload " + std::to_string(i);
+            ASSERT_TRUE(writer.write(record));
+        }
+        EXPECT_EQ(3, writer.get_record_count());
+    }
+}
+
+TEST(test_kafka_capture, write_read)
+{
+    const std::string path = "test_kafka_capture_write_read.kcap";
+    write_capture(path, "capture_topic");
+
+    kafka_clients::kafka_capture_reader reader(path);
+    ASSERT_TRUE(reader.is_open());
+    kafka_clients::capture_record record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(1000, record.timestamp);
+    EXPECT_EQ("capture_topic", record.topic);
+    EXPECT_EQ("", record.key);
+    EXPECT_EQ("payload 0", record.payload);
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(1200, record.timestamp);
+    EXPECT_EQ("vehicle_2", record.key);
+    EXPECT_EQ("payload 2", record.payload);
+    EXPECT_FALSE(reader.next(record));
+    std::remove(path.c_str());
+
+    kafka_clients::kafka_capture_reader missing_reader("missing.kcap");
+    EXPECT_FALSE(missing_reader.is_open());
+    EXPECT_FALSE(missing_reader.next(record));
+}
+
+TEST(test_kafka_capture, capture_in_process_message)
+{
+    const std::string path = "test_kafka_capture_message.kcap";
+    kafka_clients::kafka_client client(kafka_clients::kafka_transport::IN_PROCESS);
+    auto producer = client.create_producer("", "capture_message_topic");
+    auto consumer = client.create_consumer("", "capture_message_topic", "test_group");
+    ASSERT_TRUE(producer->init());
+    ASSERT_TRUE(consumer->init());
+    consumer->subscribe();
+    producer->send(std::string("captured"));
+    {
+        kafka_clients::kafka_capture_writer writer(path);
+        EXPECT_TRUE(writer.write(consumer->consume_message(10)));
+        // Empty message is not recorded
+        EXPECT_FALSE(writer.write(consumer->consume_message(0)));
+    }
+    kafka_clients::kafka_capture_reader reader(path);
+    kafka_clients::capture_record record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ("capture_message_topic", record.topic);
+    EXPECT_EQ("captured", record.payload);
+    EXPECT_GT(record.timestamp, 0);
+    EXPECT_FALSE(reader.next(record));
+    std::remove(path.c_str());
+}
+
+TEST(test_kafka_capture, replay_in_process)
+{
+    const std::string path = "test_kafka_capture_replay.kcap";
+    write_capture(path, "replay_topic");
+    kafka_clients::kafka_client client(kafka_clients::kafka_transport::IN_PROCESS);
+    auto consumer = client.create_consumer("", "replay_topic", "test_group");
+    ASSERT_TRUE(consumer->init());
+    consumer->subscribe();
+
+    // Records are 100 ms apart, 10 times capture speed replays them 10 ms apart
+    {
+        kafka_clients::kafka_capture_reader reader(path);
+        kafka_clients::kafka_replayer replayer(kafka_clients::IN_PROCESS_BROKER, 10);
+        auto result = replayer.replay(reader);
+        EXPECT_EQ(3, result.records);
+        EXPECT_EQ(27, result.bytes);
+        EXPECT_GE(result.elapsed_ms, 19);
+        EXPECT_LT(result.elapsed_ms, 200);
+    }
+    auto batch = consumer->consume_batch(10, 10);
+    ASSERT_EQ(3, batch.size());
+    EXPECT_EQ("payload 0", batch.front().payload());
+    EXPECT_EQ("payload 2", batch.back().payload());
+
+    // Max speed
+    {
+        kafka_clients::kafka_capture_reader reader(path);
+        kafka_clients::kafka_replayer replayer(kafka_clients::IN_PROCESS_BROKER, 0);
+        auto result = replayer.replay(reader);
+        EXPECT_EQ(3, result.records);
+        EXPECT_LT(result.elapsed_ms, 100);
+        EXPECT_EQ(0, result.max_behind_schedule_ms);
+    }
+    EXPECT_EQ(3, consumer->consume_batch(10, 10).size());
+    std::remove(path.c_str());
+}
@@ -22,3 +22,46 @@ TEST(test_kafka_consumer_worker, create_consumer)
         EXPECT_FALSE(worker->is_running());
     }
 }
+
+TEST(test_kafka_consumer_worker, consume_message)
+{
+    std::string broker_str = "127.0.0.1:9092";
+    std::string topic = "test";
+    std::string group = "group_one";
+    auto client = std::make_shared<kafka_clients::kafka_client>();
+    std::shared_ptr<kafka_clients::kafka_consumer_worker>  worker;
+    worker = client->create_consumer(broker_str, topic, group);
+    worker->init();
+    worker->subscribe();
+    auto message = worker->consume_message(1000);
+
+    // Run this unit test without launching kafka broker nor produce any messages to this topic.
+    EXPECT_TRUE(message.empty());
+    EXPECT_EQ(0, message.payload().length());
+    if (worker->is_running())
+    {
+        worker->stop();
+        EXPECT_FALSE(worker->is_running());
+    }
+}
+
+TEST(test_kafka_consumer_worker, consume_batch)
+{
+    std::string broker_str = "127.0.0.1:9092";
+    std::string topic = "test";
+    std::string group = "group_one";
+    auto client = std::make_shared<kafka_clients::kafka_client>();
+    std::shared_ptr<kafka_clients::kafka_consumer_worker>  worker;
+    worker = client->create_consumer(broker_str, topic, group);
+    worker->init();
+    worker->subscribe();
+    auto batch = worker->consume_batch(10, 1000);
+
+    // Run this unit test without launching kafka broker nor produce any messages to this topic.
+    EXPECT_TRUE(batch.empty());
+    if (worker->is_running())
+    {
+        worker->stop();
+        EXPECT_FALSE(worker->is_running());
+    }
+}
@@ -0,0 +1,14 @@
+#include "gtest/gtest.h"
+#include "kafka_message.h"
+
+TEST(test_kafka_message, empty_message)
+{
+    kafka_clients::kafka_message message;
+    EXPECT_TRUE(message.empty());
+    EXPECT_EQ(0, message.payload().length());
+    EXPECT_EQ(RdKafka::Topic::OFFSET_INVALID, message.offset());
+    EXPECT_EQ(-1, message.timestamp());
+
+    kafka_clients::kafka_message moved_message(std::move(message));
+    EXPECT_TRUE(moved_message.empty());
+}
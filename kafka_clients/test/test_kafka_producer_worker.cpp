@@ -15,3 +15,60 @@ TEST(test_kafka_producer_worker, create_producer)
     worker->send(msg);
     worker->stop();
 }
+
+TEST(test_kafka_producer_worker, async_producer)
+{
+    std::string broker_str = "localhost:9092";
+    std::string topic = "test";
+    auto client = std::make_shared<kafka_clients::kafka_client>();
+    std::shared_ptr<kafka_clients::kafka_producer_worker> worker;
+    worker = client->create_producer(broker_str, topic);
+    worker->set_async(true);
+    worker->set_queue_full_policy(kafka_clients::queue_full_policy::DROP_QUEUED);
+    ASSERT_TRUE(worker->init());
+    std::string msg = "test message";
+    // Without a kafka broker messages are accepted into the local queue but never delivered
+    worker->send(msg);
+    worker->send(msg);
+    auto metrics = worker->get_metrics();
+    EXPECT_EQ(2, metrics.produced);
+    EXPECT_EQ(0, metrics.delivered);
+    EXPECT_EQ(0, metrics.dropped);
+    EXPECT_EQ(2, metrics.queue_depth);
+    worker->stop();
+    EXPECT_FALSE(worker->is_running());
+}
+
+TEST(test_kafka_producer_worker, send_owned_message)
+{
+    std::string broker_str = "localhost:9092";
+    std::string topic = "test";
+    auto client = std::make_shared<kafka_clients::kafka_client>();
+    std::shared_ptr<kafka_clients::kafka_producer_worker> worker;
+    worker = client->create_producer(broker_str, topic);
+    ASSERT_TRUE(worker->init());
+    std::string msg = "test message";
+    // Payload ownership is transferred to the producer
+    worker->send(std::move(msg));
+    worker->send(std::string());
+    auto metrics = worker->get_metrics();
+    EXPECT_EQ(1, metrics.produced);
+    EXPECT_EQ(1, metrics.queue_depth);
+    worker->stop();
+}
+
+TEST(test_kafka_producer_worker, send_keyed_message)
+{
+    std::string broker_str = "localhost:9092";
+    std::string topic = "test";
+    auto client = std::make_shared<kafka_clients::kafka_client>();
+    std::shared_ptr<kafka_clients::kafka_producer_worker> worker;
+    worker = client->create_producer(broker_str, topic);
+    ASSERT_TRUE(worker->init());
+    std::string msg = "test message";
+    // Partition is selected by hashing the key
+    worker->send(msg, "DOT-45244");
+    worker->send(std::string("test message"), "DOT-45244");
+    EXPECT_EQ(2, worker->get_metrics().produced);
+    worker->stop();
+}
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include "kafka_statistics.h"
+
+TEST(test_kafka_statistics, parse_statistics)
+{
+    std::string json = R"({
+        "name": "rdkafka#consumer-1", "type": "consumer", "ts": 1650000000000000, "msg_cnt": 3, "txmsgs": 0, "rxmsgs": 120,
+        "brokers": {
+            "localhost:9092/1": { "name": "localhost:9092/1", "nodeid": 1, "outbuf_cnt": 2, 
+                                  "rtt": { "min": 100, "max": 9000, "avg": 450, "p99": 8000 } },
+            "localhost:9093/2": { "name": "localhost:9093/2", "nodeid": 2, "outbuf_cnt": 0, 
+                                  "rtt": { "min": 100, "max": 3000, "avg": 300, "p99": 2500 } }
+        },
+        "topics": {
+            "v2xhub_bsm_in": { "topic": "v2xhub_bsm_in", "partitions": {
+                "0": { "partition": 0, "msgq_cnt": 1, "xmit_msgq_cnt": 2, "txmsgs": 0, "rxmsgs": 100, "consumer_lag": 40 },
+                "1": { "partition": 1, "msgq_cnt": 0, "xmit_msgq_cnt": 0, "txmsgs": 0, "rxmsgs": 20, "consumer_lag": 2 },
+                "-1": { "partition": -1, "msgq_cnt": 0, "xmit_msgq_cnt": 0, "txmsgs": 0, "rxmsgs": 0, "consumer_lag": -1 }
+            } }
+        }
+    })";
+    kafka_clients::kafka_statistics stats;
+    ASSERT_TRUE(kafka_clients::parse_statistics(json, stats));
+    EXPECT_EQ(1650000000000000, stats.timestamp_us);
+    EXPECT_EQ(120, stats.rxmsgs);
+    EXPECT_EQ(3, stats.outq_msgs);
+    ASSERT_EQ(2, stats.brokers.size());
+    EXPECT_EQ(8000, stats.max_rtt_p99_us());
+    // Internal partition -1 is skipped
+    ASSERT_EQ(2, stats.partitions.size());
+    EXPECT_EQ(3, stats.partitions.front().outq_msgs);
+    EXPECT_EQ(42, stats.consumer_lag("v2xhub_bsm_in"));
+    EXPECT_EQ(-1, stats.consumer_lag("unknown_topic"));
+
+    EXPECT_FALSE(kafka_clients::parse_statistics("not json", stats));
+}
+
+TEST(test_kafka_statistics, statistics_store)
+{
+    kafka_clients::kafka_statistics_store store;
+    EXPECT_EQ(0, store.get().timestamp_us);
+    store.throttled(50);
+    store.update(R"({"ts": 10, "rxmsgs": 5})");
+    auto stats = store.get();
+    EXPECT_EQ(10, stats.timestamp_us);
+    EXPECT_EQ(5, stats.rxmsgs);
+    EXPECT_EQ(1, stats.throttle_count);
+    EXPECT_EQ(50, stats.last_throttle_time_ms);
+}
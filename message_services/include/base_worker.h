@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "baseMessage.h"
 
@@ -18,9 +19,14 @@ namespace message_services
             ~base_worker();
             /***
             * @brief process incoming msg json string and create msg object.
-              @param std::string json_string
+              @param std::string_view json_string
             */
-            virtual void process_incoming_msg(const std::string json_str) = 0;
+            virtual void process_incoming_msg(std::string_view json_str) = 0;
+            /***
+            * @brief Drop all messages held by the worker, e.g. after the partitions they were consumed from were
+              revoked from this service instance.
+            */
+            virtual void clear_state() = 0;
         };
     }
 }
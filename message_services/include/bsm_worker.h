@@ -5,10 +5,12 @@
 
 #include <vector>
 #include <mutex>
+#include <unordered_map>
 
 #include "bsm.h"
 #include "kafka_client.h"
 #include "base_worker.h"
+#include "timing_wheel.h"
 
 namespace message_services
 {
@@ -18,7 +20,11 @@ namespace message_services
         {
         private:
             std::deque<message_services::models::bsm> bsm_v;
-            std::map<std::string ,message_services::models::bsm> bsm_m;
+            std::unordered_map<models::correlation_key_t, message_services::models::bsm, models::correlation_key_hash> bsm_m;
+            // Expiry deadlines of the bsm map entries
+            timing_wheel<models::correlation_key_t> _expiry_wheel;
+            // Time in milliseconds after which a stored bsm expires
+            std::time_t _expiry_window_ms = 1000;
 
         public:
             bsm_worker();
@@ -27,15 +33,34 @@ namespace message_services
              * @brief Return the vector of bsm stored in the bsm_worker
              * ***/
             std::deque<models::bsm>& get_curr_list();
-            std::map<std::string ,message_services::models::bsm> &get_curr_map();
+            std::unordered_map<models::correlation_key_t, message_services::models::bsm, models::correlation_key_hash> &get_curr_map();
             
             std::mutex worker_mtx;
             /***
             * @brief process incoming bsm json string and create bsm object.
               Appending the bsm object to the bsm_list
-              @param std::string json_string
+              @param std::string_view json_string
             */
-            void process_incoming_msg(const std::string json_str);
+            void process_incoming_msg(std::string_view json_str) override;
+            /***
+            * @brief process incoming bsm json string and store the bsm object in the bsm map.
+              @param std::string_view json_string
+              @param correlation_key_t bsm_msg_key map key of the stored bsm
+              @return true if the bsm was parsed and stored
+            */
+            bool process_incoming_msg(std::string_view json_str, models::correlation_key_t &bsm_msg_key);
+            void clear_state() override;
+            /**
+             * @brief Set the time after which stored bsm messages expire. Applies to messages stored after the call.
+             * @param expiry_window_ms time in milliseconds
+             * **/
+            void set_expiry_window(std::time_t expiry_window_ms);
+            /**
+             * @brief Remove bsm messages received expiry window or longer before cur_timestamp. Only visits expired entries.
+             * @param cur_timestamp current time in milliseconds since epoch
+             * @return number of removed messages
+             * **/
+            std::size_t expire(std::time_t cur_timestamp);
             
             /**
              * @brief Remove an element from bsm vector based on the element position.
@@ -0,0 +1,88 @@
+#ifndef EST_PATH_LOAD_CONTROLLER_H
+#define EST_PATH_LOAD_CONTROLLER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+
+namespace message_services
+{
+    namespace services
+    {
+        typedef struct est_path_settings
+        {
+            // true: Not show est path in the vsi message
+            bool disable_est_path = false;
+            // true: est path distances are distances to the previous point instead of distances to the lanelet end
+            bool is_est_path_p2p_distance_only = false;
+            // Maximum number of points in the est path, 0 for all MobilityPath offsets
+            std::int64_t est_path_point_count = 0;
+        } est_path_settings_t;
+
+        /**
+         * @brief Steps the est path generation down under overload and back up when the load drops. Load is the time the
+         * compose thread needs to work off its backlog, the number of queued correlated messages times the average
+         * compose time per vehicle status and intent. Levels from the configured settings down:
+         *  - 0: configured settings
+         *  - 1: half the est path points
+         *  - 2: half the est path points with point to point distances, which need no lanelet lookup
+         *  - 3: no est path
+         * The level steps down while the load exceeds the budget and steps up after the load stayed below a quarter of
+         * the budget for STEP_UP_HOLD_MS. Not thread safe, all calls are expected from the compose thread.
+         */
+        class est_path_load_controller
+        {
+        private:
+            est_path_settings_t _configured;
+            est_path_settings_t _settings;
+            // Maximum time in milliseconds to work off the backlog, 0 disables load adaptation
+            std::int64_t _load_budget_ms = 0;
+            int _level = 0;
+            // Exponentially weighted average compose time per vehicle status and intent in milliseconds
+            double _avg_compose_ms = 0;
+            bool _has_avg_compose_ms = false;
+            std::time_t _last_step_timestamp = 0;
+            // Time since the load is below the step up threshold, 0 if it is not
+            std::time_t _low_load_since = 0;
+
+            void set_level(int level, std::time_t cur_timestamp);
+
+        public:
+            static constexpr int MAX_LEVEL = 3;
+            // Weight of the latest batch in the average compose time
+            static constexpr double COMPOSE_TIME_WEIGHT = 0.2;
+            // Minimum time between two step downs
+            static constexpr std::time_t STEP_DOWN_INTERVAL_MS = 200;
+            // Time the load has to stay low before stepping up
+            static constexpr std::time_t STEP_UP_HOLD_MS = 2000;
+            // Est path points from level 1 on if all MobilityPath offsets are configured
+            static constexpr std::int64_t REDUCED_POINT_COUNT = 10;
+
+            est_path_load_controller() = default;
+            est_path_load_controller(const est_path_settings_t &configured, std::int64_t load_budget_ms);
+
+            /**
+             * @brief Update the load with a composed batch and step the level.
+             * @param backlog number of correlated messages waiting after the batch was composed
+             * @param batch_size number of vehicle status and intent composed in the batch
+             * @param batch_compose_ms time in milliseconds to compose the batch
+             * @param cur_timestamp current time in milliseconds since epoch
+             * **/
+            void on_batch(std::size_t backlog, std::size_t batch_size, double batch_compose_ms, std::time_t cur_timestamp);
+
+            /**
+             * @brief Est path settings of the current level.
+             * **/
+            const est_path_settings_t &get_settings() const;
+
+            int get_level() const;
+
+            /**
+             * @brief Estimated time in milliseconds to compose backlog vehicle status and intent at the current level.
+             * **/
+            double estimate_load_ms(std::size_t backlog) const;
+        };
+    }
+}
+
+#endif
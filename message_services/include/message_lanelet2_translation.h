@@ -48,6 +48,10 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <map>
+#include <unordered_map>
+#include <limits>
+#include <functional>
+#include <algorithm>
 #include <intersection_lanelet_type.h>
 #include <trajectory.h>
 
@@ -59,7 +63,7 @@ namespace message_services
         {
         private:
             lanelet::LaneletMapPtr map_ptr;
-            lanelet::projection::LocalFrameProjector *local_projector;
+            lanelet::projection::LocalFrameProjector *local_projector = nullptr;
             double laneChangeCost = 2.;
             double participantHeight = 2.;
             double minLaneChangeLength = 0.;
@@ -71,6 +75,100 @@ namespace message_services
             // Routing graph is used to store the possible routing set
             lanelet::routing::RoutingGraphPtr vehicleGraph_ptr;
 
+            /**
+             * Uniform grid over the bounding boxes of the intersection entry, link and departure lanelets. Each cell
+             * lists the lanelets whose bounding box overlaps it, so a point lookup only tests the lanelets of one cell.
+             * The grid is empty if the map has no all_way_stop intersection.
+             * **/
+            // Cells are at least this many meters wide and the grid has at most _maximum_num_grid_cells cells
+            const double _minimum_grid_cell_size = 5.0;
+            const std::size_t _maximum_num_grid_cells = 4096;
+            double _grid_cell_size = 0;
+            lanelet::BasicPoint2d _grid_origin = lanelet::BasicPoint2d(0, 0);
+            std::size_t _grid_cols = 0;
+            std::size_t _grid_rows = 0;
+            std::vector<std::vector<lanelet::Lanelet>> _grid_cells;
+
+            /**
+             * Centerline points of a lanelet with the arc length from the first point to each point.
+             * **/
+            struct centerline_arc_length_t
+            {
+                lanelet::BasicLineString2d points;
+                std::vector<double> arc_lengths;
+            };
+
+            // Centerline arc length tables of all map lanelets by lanelet id, built when the map is read
+            std::unordered_map<lanelet::Id, centerline_arc_length_t> _centerline_arc_lengths;
+
+            /**
+             * @brief Build the centerline arc length table of a lanelet.
+             */
+            static centerline_arc_length_t build_centerline_arc_length(const lanelet::ConstLanelet &subj_lanelet);
+
+            /**
+             * Linearized ECEF to map projection around a reference point, see init_linearized_projection. A map point
+             * is _map_reference + _ecef_2_map_jacobian * (ecef - _ecef_reference) with ECEF in meters.
+             * **/
+            bool _is_linearized_projection = false;
+            double _linearized_projection_radius = 0;
+            Eigen::Matrix3d _ecef_2_map_jacobian = Eigen::Matrix3d::Identity();
+            lanelet::BasicPoint3d _ecef_reference = lanelet::BasicPoint3d(0, 0, 0);
+            lanelet::BasicPoint3d _map_reference = lanelet::BasicPoint3d(0, 0, 0);
+
+            /**
+             * @brief Project an ECEF location in meters with the local frame projector.
+             */
+            lanelet::BasicPoint3d project_ecef_exact(const lanelet::BasicPoint3d &ecef_point) const;
+
+            /**
+             * @brief Project an ECEF location in meters, with the linearized projection if it is within its radius.
+             */
+            lanelet::BasicPoint3d project_ecef(const lanelet::BasicPoint3d &ecef_point) const;
+
+            // Ids of the turn_direction attribute values of the map, starting at 1. 0 stands for any other turn direction.
+            std::unordered_map<std::string, std::size_t> _turn_direction_ids;
+
+            // Intersection lanelet types and ids by lanelet id and turn direction id, see get_lanelet_types_ids
+            std::unordered_map<lanelet::Id, std::vector<std::map<int64_t, models::intersection_lanelet_type>>> _lanelet_types_table;
+
+            /**
+             * @brief Whether the lanelet has an all_way_stop regulatory element, which marks the intersection entry lanelets.
+             */
+            static bool is_all_way_stop_entry(const lanelet::ConstLanelet &subj_lanelet);
+
+            /**
+             * @brief The entry lanelets, the link lanelets following them and the departure lanelets following the links
+             * by lanelet id. Requires the routing graph.
+             */
+            std::map<lanelet::Id, lanelet::Lanelet> get_intersection_lanelets() const;
+
+            /**
+             * @brief Fill the lanelet types table for every intersection lanelet and turn direction of the map.
+             */
+            void build_lanelet_types_table();
+
+            /**
+             * @brief Walk the routing graph to determine the entry, link and departure lanelet of the subject lanelet.
+             * @param turn_direction_id turn direction of the vehicle, 0 matches no link lanelet.
+             * @param turn_direction_id_of turn direction id of a lanelet.
+             */
+            std::map<int64_t, models::intersection_lanelet_type> compute_lanelet_types_ids(const lanelet::ConstLanelet &subj_lanelet, std::size_t turn_direction_id,
+                                                                                         const std::function<std::size_t(const lanelet::ConstLanelet &)> &turn_direction_id_of) const;
+
+            /**
+             * @brief Index the entry lanelets (lanelets with an all_way_stop regulatory element), their following link
+             * lanelets and the departure lanelets following those in the uniform grid. Requires the routing graph.
+             * @return the number of indexed lanelets.
+             */
+            std::size_t build_intersection_lanelet_index();
+
+            /**
+             * @brief Intersection lanelets containing the point, looked up in the uniform grid.
+             * @return empty vector if the point is outside the indexed intersection lanelets.
+             */
+            std::vector<lanelet::Lanelet> get_intersection_lanelets_by_point(const lanelet::BasicPoint2d &subj_point2d) const;
+
         public:
             message_lanelet2_translation(/* args */);
             message_lanelet2_translation(std::string filename);
@@ -102,7 +200,8 @@ namespace message_services
              lanelet::Lanelet get_cur_lanelet_by_point_and_direction(lanelet::BasicPoint3d subj_point3d, std::string turn_direction, models::trajectory& trajectory) const;
             
              /***
-             * @brief Identify the current lanelet with the given vehicle geo-loc (convert into map point).
+             * @brief Identify the current lanelet with the given vehicle geo-loc (convert into map point). Points within
+             * the intersection are looked up in the intersection lanelet index, other points in the whole map.
              * @param BasicPoint3d 
              * @return a vector of lanelets; \n Return empty vetor if cannot find the current lanelets.
              **/
@@ -121,6 +220,7 @@ namespace message_services
             
             /***
              * @brief The distance between the vehicle’s current position and the end of its current lane with the given vehicle geo-loc and vehicle turn direction.
+             * The distance is measured along the centerline from the projection of the position onto the nearest centerline segment.
              * @param BasicPoint3d
              * @param turn_direction (Optional if position is not in intersection bridge/link lanelet).
              * @return Decimal distance to the end of the current lanelet (unit of meters). 
@@ -136,6 +236,7 @@ namespace message_services
 
             /***
              * @brief Vehicle broadcast mobilityoperation message that contains current vehicle lanelet and vehicle turn direction.
+             * Looked up in the table built with the routing graph.
              * @param subj_lanelet
              * @param turn_direction
              * @return A map of lanelet_id and intersection lanelet type (entry, departure, link or unknown)
@@ -149,6 +250,26 @@ namespace message_services
             */
             lanelet::BasicPoint3d ecef_2_map_point(std::int32_t ecef_x, std::int32_t ecef_y, std::int32_t ecef_z) const;
 
+            /**
+             * @brief Replace the ECEF to map projection within radius meters of the intersection (the center of the
+             * indexed intersection lanelets, or the map origin) by its linearization, a rotation and translation that
+             * avoids PROJ calls. The linearization is checked against the exact projection on points radius away
+             * in the horizontal plane and vertically, and is only enabled if the largest deviation is at most max_error
+             * meters. Ignoring the Earth curvature deviates about 3 mm at 200 m.
+             * @param radius in meters, 0 disables the linearized projection.
+             * @param max_error in meters.
+             * @return true if the linearized projection is enabled.
+             */
+            bool init_linearized_projection(double radius, double max_error = 0.005);
+
+            /**
+             * @brief Convert the trajectory location and the locations after the cumulative offsets at offset_indices to
+             * map points. Offsets are summed once up to the last index and only the requested locations are projected.
+             * @param offset_indices ascending offset indices, indices past the last offset are ignored.
+             * @return map points of the trajectory location followed by the location of each offset index.
+             */
+            std::vector<lanelet::BasicPoint3d> trajectory_2_map_points(const models::trajectory &trajectory, const std::vector<std::size_t> &offset_indices) const;
+
             /**
             * @brief Function to convert long lat location to a 2d ecef location
             * @param lat latiture in degrees
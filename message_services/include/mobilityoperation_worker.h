@@ -29,9 +29,17 @@ namespace message_services
             /***
             * @brief process incoming mobilityoperation json string and create mobilityoperation object.
               Appending the mobilityoperation object to the mobilityoperation_list
-              @param std::string json_string
+              @param std::string_view json_string
             */
-            void process_incoming_msg(const std::string json_str);
+            void process_incoming_msg(std::string_view json_str) override;
+            /***
+            * @brief parse incoming mobilityoperation json string without appending it to the mobilityoperation_list.
+              @param std::string_view json_string
+              @param mobilityoperation parsed mobilityoperation object
+              @return true if the mobilityoperation was parsed
+            */
+            bool parse_incoming_msg(std::string_view json_str, models::mobilityoperation &mobilityoperation_obj) const;
+            void clear_state() override;
 
             /**
              * @brief Remove an element from mobilityoperation vector based on the element position.
@@ -2,10 +2,12 @@
 #define MOBILITYPATH_WORKER_H
 
 #include <iostream>
+#include <unordered_map>
 
 #include "kafka_client.h"
 #include "mobilitypath.h"
 #include "base_worker.h"
+#include "timing_wheel.h"
 
 namespace message_services
 {
@@ -15,7 +17,11 @@ namespace message_services
         {
         private:
             std::deque<message_services::models::mobilitypath> mobilitypath_v;
-            std::map<std::string ,message_services::models::mobilitypath> mobilitypath_m;
+            std::unordered_map<models::correlation_key_t, message_services::models::mobilitypath, models::correlation_key_hash> mobilitypath_m;
+            // Expiry deadlines of the mobilitypath map entries
+            timing_wheel<models::correlation_key_t> _expiry_wheel;
+            // Time in milliseconds after which a stored mobilitypath expires
+            std::time_t _expiry_window_ms = 1000;
 
         public:
             mobilitypath_worker();
@@ -28,14 +34,33 @@ namespace message_services
              * @brief Return the vector of mobilitypath stored in the mobilitypath_worker
              * ***/
             std::deque<models::mobilitypath> &get_curr_list();
-            std::map<std::string ,message_services::models::mobilitypath> &get_curr_map();
+            std::unordered_map<models::correlation_key_t, message_services::models::mobilitypath, models::correlation_key_hash> &get_curr_map();
 
             /***
             * @brief process incoming mobilitypath json string and create mobilitypath object.
               Appending the mobilitypath object to the mobilitypath_list
-              @param std::string json_string
+              @param std::string_view json_string
             */
-            void process_incoming_msg(const std::string json_str);
+            void process_incoming_msg(std::string_view json_str) override;
+            /***
+            * @brief process incoming mobilitypath json string and store the mobilitypath object in the mobilitypath map.
+              @param std::string_view json_string
+              @param correlation_key_t mp_msg_key map key of the stored mobilitypath
+              @return true if the mobilitypath was parsed and stored
+            */
+            bool process_incoming_msg(std::string_view json_str, models::correlation_key_t &mp_msg_key);
+            void clear_state() override;
+            /**
+             * @brief Set the time after which stored mobilitypath messages expire. Applies to messages stored after the call.
+             * @param expiry_window_ms time in milliseconds
+             * **/
+            void set_expiry_window(std::time_t expiry_window_ms);
+            /**
+             * @brief Remove mobilitypath messages received expiry window or longer before cur_timestamp. Only visits expired entries.
+             * @param cur_timestamp current time in milliseconds since epoch
+             * @return number of removed messages
+             * **/
+            std::size_t expire(std::time_t cur_timestamp);
 
             /**
              * @brief Remove an element from mobilitypath vector based on the element position.
@@ -0,0 +1,115 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+#include <ctime>
+#include <algorithm>
+
+namespace message_services
+{
+    namespace workers
+    {
+        /**
+         * @brief Hashed timing wheel of key deadlines. Keys are scheduled in the slot of their deadline tick and
+         * advance() only visits the slots of the ticks that passed since the previous call, so expiring keys costs
+         * O(expired + elapsed ticks) instead of a sweep over all stored keys. Deadlines further out than the span of
+         * the wheel are kept in their slot until the wheel has turned far enough.
+         * Not thread safe, callers guard the wheel together with the map it expires.
+         */
+        template <typename Key>
+        class timing_wheel
+        {
+        private:
+            struct entry
+            {
+                Key key;
+                std::time_t deadline;
+            };
+
+            std::vector<std::vector<entry>> _slots;
+            std::time_t _tick_ms;
+            // Last tick fully processed by advance(). -1 until the first call.
+            std::time_t _processed_tick = -1;
+            std::size_t _size = 0;
+
+            std::size_t slot_index(std::time_t tick) const
+            {
+                return static_cast<std::size_t>(tick) % _slots.size();
+            }
+
+        public:
+            /**
+             * @param span_ms time span covered by one turn of the wheel, usually the expiry window
+             * @param tick_ms time span of one slot
+             * **/
+            explicit timing_wheel(std::time_t span_ms = 1000, std::time_t tick_ms = 10) : _tick_ms(std::max<std::time_t>(tick_ms, 1))
+            {
+                _slots.resize(static_cast<std::size_t>(std::max<std::time_t>(span_ms, 0) / _tick_ms) + 1);
+            }
+
+            /**
+             * @brief Schedule key to expire at deadline. Keys scheduled more than once expire once per schedule.
+             * @param key to expire
+             * @param deadline in milliseconds since epoch
+             * **/
+            void schedule(const Key &key, std::time_t deadline)
+            {
+                std::time_t tick = deadline / _tick_ms;
+                if (_processed_tick >= 0 && tick <= _processed_tick)
+                {
+                    tick = _processed_tick + 1;
+                }
+                _slots[slot_index(tick)].push_back({key, deadline});
+                _size++;
+            }
+
+            /**
+             * @brief Remove keys with a deadline at or before cur_timestamp and call on_expired(key) for each of them.
+             * @param cur_timestamp in milliseconds since epoch
+             * **/
+            template <typename Callback>
+            void advance(std::time_t cur_timestamp, Callback &&on_expired)
+            {
+                std::time_t cur_tick = cur_timestamp / _tick_ms;
+                if (_processed_tick < 0 || cur_tick - _processed_tick > static_cast<std::time_t>(_slots.size()))
+                {
+                    // Visit every slot once
+                    _processed_tick = cur_tick - static_cast<std::time_t>(_slots.size());
+                }
+                for (std::time_t tick = _processed_tick + 1; tick <= cur_tick; tick++)
+                {
+                    auto &slot = _slots[slot_index(tick)];
+                    auto keep_itr = std::partition(slot.begin(), slot.end(), [cur_timestamp](const entry &e)
+                                                   { return e.deadline > cur_timestamp; });
+                    for (auto itr = keep_itr; itr != slot.end(); ++itr)
+                    {
+                        on_expired(itr->key);
+                    }
+                    _size -= static_cast<std::size_t>(slot.end() - keep_itr);
+                    slot.erase(keep_itr, slot.end());
+                }
+                // Entries of the current tick with a later deadline are revisited by the next call
+                _processed_tick = cur_tick - 1;
+            }
+
+            void clear()
+            {
+                for (auto &slot : _slots)
+                {
+                    slot.clear();
+                }
+                _size = 0;
+            }
+
+            /**
+             * @brief Number of scheduled keys not expired yet.
+             * **/
+            std::size_t size() const
+            {
+                return _size;
+            }
+        };
+    }
+}
+
+#endif
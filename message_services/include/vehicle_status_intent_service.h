@@ -5,13 +5,14 @@
 #include <thread>
 #include <vector>
 #include <map>
+#include <deque>
+#include <condition_variable>
 #include <stdlib.h> /* abs */
 #include <lanelet2_core/Exceptions.h>
 
 
-#include "bsm_worker.h"
-#include "mobilitypath_worker.h"
-#include "mobilityoperation_worker.h"
+#include "vsi_correlation_engine.h"
+#include "est_path_load_controller.h"
 #include "vehicle_status_intent.h"
 #include "kafka_client.h"
 #include "message_lanelet2_translation.h"
@@ -23,28 +24,20 @@ namespace message_services
 {
     namespace services
     {
-        typedef struct vsi_message_bucket
-        {
-            models::mobilityoperation mo;
-            models::bsm bsm;
-            models::mobilitypath mp;
-        } vsi_message_bucket_t;
-
         class vehicle_status_intent_service
         {
         private:
             std::string bootstrap_server;
-            std::string bsm_group_id;
+            std::string consumer_group_id;
             std::string bsm_topic_name;
-            std::string mo_group_id;
             std::string mo_topic_name;
-            std::string mp_group_id;
             std::string mp_topic_name;
             std::string vsi_topic_name;
+            // Static consumer group membership id of this service instance. Empty if only one instance is deployed.
+            std::string instance_id;
             std::shared_ptr<kafka_clients::kafka_producer_worker> _vsi_producer_worker;
-            std::shared_ptr<kafka_clients::kafka_consumer_worker> _mo_consumer_worker;
-            std::shared_ptr<kafka_clients::kafka_consumer_worker> _mp_consumer_worker;
-            std::shared_ptr<kafka_clients::kafka_consumer_worker> _bsm_consumer_worker;
+            // Single consumer subscribed to the BSM, MobilityPath and MobilityOperation topics
+            std::shared_ptr<kafka_clients::kafka_consumer_worker> _consumer_worker;
             std::int64_t vsi_est_path_point_count = 0;
             bool disable_est_path = false; // false: Show est path in the vsi message. true: Not show
             /***
@@ -52,6 +45,10 @@ namespace message_services
              * True: First point in est_path includes distance to current vehicle location, and timestamp. Following points in est_path include distance to previous point and timestamp 
             **/
             bool is_est_path_p2p_distance_only = false; 
+            // Radius in meters around the intersection of the linearized ECEF to map projection. 0 uses the exact projection.
+            double linearized_projection_radius = 0;
+            // Maximum time in milliseconds to compose the backlog before est path generation steps down. 0 disables load adaptation.
+            std::int64_t est_path_load_budget_ms = 0;
 
             //Mapping MobilityOperation and BSM msg_count maximum allowed differences.
             std::int32_t MOBILITY_OPERATION_BSM_MAX_COUNT_OFFSET = 0;
@@ -62,17 +59,21 @@ namespace message_services
             //The duration between the offset points in mobilitypath message. Default duration is MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION * 100 (milliseconds)
             std::uint32_t MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION = 1;
 
-            //Publish vehicle status intent thread sleep time.
-            unsigned int VSI_TH_SLEEP_MILLI_SEC = 100; 
+            //Maximum number of messages the consumer thread consumes and correlates per batch.
+            std::size_t CONSUMER_BATCH_SIZE = 100;
 
             //Expire BSM message from the queue after duration. Default value is 6 seconds
             unsigned long BSM_MSG_EXPIRE_IN_SEC = 6; 
 
-            //Clean the queue every CLEAN_QUEUE_IN_SECS; 
+            //Drop messages not correlated within CLEAN_QUEUE_IN_SECS
             std::int32_t CLEAN_QUEUE_IN_SECS = 0;
 
-            //Tracking last message expired timestamp
-            std::time_t prev_msg_expired_timestamp_ = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();                      
+            //Correlated BSM, MobilityOperation and MobilityPath waiting to be composed into vehicle status and intent
+            std::deque<vsi_message_bucket_t> _compose_queue;
+            std::mutex _compose_mtx;
+            std::condition_variable _compose_cv;
+            //Est path settings adapted to the compose load, only used by the compose thread
+            est_path_load_controller _est_path_controller;
 
             //add lanelet2 translation object
             std::shared_ptr<message_translations::message_lanelet2_translation> _msg_lanelet2_translate_ptr;
@@ -96,7 +97,8 @@ namespace message_services
             void start();
 
             /**
-             * @brief Creating and running threads. Each thread is acting as consumer or producer to consume or produce messages to topics
+             * @brief Creating and running threads. The consumer thread consumes and correlates messages, the compose thread composes and
+             * publishes vehicle status and intent messages for the correlated messages
              * @param pointers to workers that will be used to work on messages that are consumed
              * **/
             void run(std::shared_ptr<message_services::workers::bsm_worker> bsm_w_ptr,
@@ -110,18 +112,25 @@ namespace message_services
             models::vehicle_status_intent compose_vehicle_status_intent(models::bsm &bsm, models::mobilityoperation &mo, models::mobilitypath &mp);
 
             /**
-             * @brief Consume a message from particular topic and convert the message as an object. Then  append the message to its corresponding worker
-             * @param pointers to object that will store the message consumed. topic from which the message is from. The group id of the consumer
+             * @brief Consume messages from the BSM, MobilityPath and MobilityOperation topics and convert each message to an object. Then dispatch
+             * the message by topic to the correlation engine and queue correlated messages for the compose thread
+             * @param pointers to workers that will store the messages consumed
+             * **/
+            void msg_consumer(std::shared_ptr<message_services::workers::bsm_worker> bsm_w_ptr,
+                              std::shared_ptr<message_services::workers::mobilitypath_worker> mp_w_ptr,
+                              std::shared_ptr<message_services::workers::mobilityoperation_worker> mo_w_ptr);
+
+            /**
+             * @brief Wait for correlated messages, compose the vehicle status and intent and publish it. Runs until the consumer stops.
              * **/
-            template <class T>
-            void msg_consumer(std::shared_ptr<T> msg_ptr,  std::shared_ptr<kafka_clients::kafka_consumer_worker>  consumer_worker);
+            void vsi_composer();
 
             /**
              * @brief Producer a message to a topic
-             * @param pointer to object that will be published, and a topic name
+             * @param serialized message that will be published. Ownership is transferred to the producer, the message key used to select the 
+             * partition (vehicle id), and the producer for the topic
              * **/
-            template <typename T>
-            void publish_msg(T msg,  std::shared_ptr<kafka_clients::kafka_producer_worker>  producer_worker);
+            void publish_msg(std::string &&msg, const std::string &key, std::shared_ptr<kafka_clients::kafka_producer_worker>  producer_worker);
         };
     }
 }
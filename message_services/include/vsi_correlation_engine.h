@@ -0,0 +1,122 @@
+#ifndef VSI_CORRELATION_ENGINE_H
+#define VSI_CORRELATION_ENGINE_H
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <string_view>
+
+#include "bsm_worker.h"
+#include "mobilitypath_worker.h"
+#include "mobilityoperation_worker.h"
+
+namespace message_services
+{
+    namespace services
+    {
+        typedef struct vsi_message_bucket
+        {
+            models::mobilityoperation mo;
+            models::bsm bsm;
+            models::mobilitypath mp;
+        } vsi_message_bucket_t;
+
+        enum class correlation_msg_type
+        {
+            BSM = 0,
+            MOBILITY_PATH = 1,
+            MOBILITY_OPERATION = 2
+        };
+
+        /**
+         * @brief Joins BSM, MobilityOperation and MobilityPath messages of a vehicle as they arrive. A MobilityOperation
+         * refers to its BSM by BSM id, msg_count and sec_mark and to its MobilityPath by sender id and timestamp. The join
+         * is attempted when any of the three messages arrives, so a vehicle status and intent can be composed as soon as
+         * the last message of the triple is consumed. MobilityOperations waiting for their BSM or MobilityPath are
+         * indexed by both keys. Not thread safe, all calls are expected from the consumer thread.
+         */
+        class vsi_correlation_engine
+        {
+        private:
+            struct pending_mo
+            {
+                models::mobilityoperation mo;
+                models::correlation_key_t bsm_msg_key;
+                models::correlation_key_t mp_msg_key;
+            };
+
+            std::shared_ptr<workers::bsm_worker> _bsm_w_ptr;
+            std::shared_ptr<workers::mobilitypath_worker> _mp_w_ptr;
+            std::shared_ptr<workers::mobilityoperation_worker> _mo_w_ptr;
+
+            // MobilityOperations waiting for their BSM or MobilityPath in arrival order.
+            std::list<pending_mo> _pending_mo;
+            std::unordered_multimap<models::correlation_key_t, std::list<pending_mo>::iterator, models::correlation_key_hash> _pending_by_bsm_key;
+            std::unordered_multimap<models::correlation_key_t, std::list<pending_mo>::iterator, models::correlation_key_hash> _pending_by_mp_key;
+
+            //Mapping MobilityOperation and MobilityPath timestamp duration within 1000 ms.
+            std::int32_t MOBILITY_OPERATION_PATH_MAX_DURATION = 1000;
+
+            //BSM older than BSM_MSG_EXPIRE_IN_MS are not correlated.
+            std::int64_t BSM_MSG_EXPIRE_IN_MS = 6000;
+
+            //Messages waiting for correlation CLEAN_QUEUE_IN_MS or longer are dropped by expire().
+            std::int64_t CLEAN_QUEUE_IN_MS = 0;
+
+            /**
+             * @brief Correlate pending MobilityOperation with its stored BSM and MobilityPath. Consumes the BSM and
+             * MobilityPath on success.
+             * @return true if the pending MobilityOperation was correlated and appended to completed.
+             * **/
+            bool try_complete(const pending_mo &pending, std::time_t cur_timestamp, std::vector<vsi_message_bucket_t> &completed);
+            /**
+             * @brief Remove pending MobilityOperation and its index entries.
+             * **/
+            void erase_pending(std::list<pending_mo>::iterator pending_itr);
+            /**
+             * @brief Complete pending MobilityOperations indexed by msg_key in index.
+             * **/
+            void complete_pending(std::unordered_multimap<models::correlation_key_t, std::list<pending_mo>::iterator, models::correlation_key_hash> &index,
+                                  const models::correlation_key_t &msg_key, std::vector<vsi_message_bucket_t> &completed);
+            void on_bsm(std::string_view json_str, std::vector<vsi_message_bucket_t> &completed);
+            void on_mp(std::string_view json_str, std::vector<vsi_message_bucket_t> &completed);
+            void on_mo(std::string_view json_str, std::vector<vsi_message_bucket_t> &completed);
+
+        public:
+            vsi_correlation_engine(std::shared_ptr<workers::bsm_worker> bsm_w_ptr,
+                                   std::shared_ptr<workers::mobilitypath_worker> mp_w_ptr,
+                                   std::shared_ptr<workers::mobilityoperation_worker> mo_w_ptr);
+
+            void set_bsm_msg_expire_in_ms(std::int64_t bsm_msg_expire_in_ms);
+            void set_clean_queue_in_ms(std::int64_t clean_queue_in_ms);
+            void set_mobility_operation_path_max_duration(std::int32_t max_duration);
+
+            /**
+             * @brief Store the consumed message and correlate it with the messages it completes.
+             * @param type of consumed message
+             * @param json_str consumed message
+             * @param completed correlated BSM, MobilityOperation and MobilityPath triples are appended to completed
+             * **/
+            void on_message(correlation_msg_type type, std::string_view json_str, std::vector<vsi_message_bucket_t> &completed);
+
+            /**
+             * @brief Drop BSM, MobilityPath and pending MobilityOperation received CLEAN_QUEUE_IN_MS or longer before cur_timestamp.
+             * Cost is proportional to the number of expired messages, so it can be called after every consumed batch.
+             * @param cur_timestamp current time in milliseconds since epoch
+             * **/
+            void expire(std::time_t cur_timestamp);
+
+            /**
+             * @brief Drop all stored messages, e.g. after the partitions they were consumed from were revoked.
+             * **/
+            void clear_state();
+
+            /**
+             * @brief Number of MobilityOperations waiting for their BSM or MobilityPath.
+             * **/
+            std::size_t get_pending_count() const;
+        };
+    }
+}
+
+#endif
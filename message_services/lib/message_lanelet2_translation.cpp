@@ -4,6 +4,24 @@ namespace message_services
 {
     namespace message_translations
     {
+        namespace
+        {
+            /**
+             * @brief WGS84 geodetic location (degrees, meters) to ECEF in meters.
+             */
+            lanelet::BasicPoint3d wgs84_2_ecef(double lat, double lon, double elev)
+            {
+                const double semi_major_axis = 6378137.0;
+                const double eccentricity2 = 6.69437999014e-3;
+                double lat_rad = lat * M_PI / 180.0;
+                double lon_rad = lon * M_PI / 180.0;
+                double prime_vertical_radius = semi_major_axis / std::sqrt(1 - eccentricity2 * std::sin(lat_rad) * std::sin(lat_rad));
+                return lanelet::BasicPoint3d((prime_vertical_radius + elev) * std::cos(lat_rad) * std::cos(lon_rad),
+                                             (prime_vertical_radius + elev) * std::cos(lat_rad) * std::sin(lon_rad),
+                                             (prime_vertical_radius * (1 - eccentricity2) + elev) * std::sin(lat_rad));
+            }
+        }
+
         message_lanelet2_translation::message_lanelet2_translation(/* args */) {}
 
         message_lanelet2_translation::message_lanelet2_translation(std::string filename)
@@ -23,6 +41,7 @@ namespace message_services
                         throw exceptions::message_lanelet2_translation_exception("Failed to update vehicle routing graph.");
                     }
                 }
+                SPDLOG_INFO("Indexed {0} intersection lanelets. ", this->build_intersection_lanelet_index());
             }
             else
             {
@@ -47,6 +66,11 @@ namespace message_services
                 this->map_ptr = lanelet::load(filename, *local_projector, &errors);
                 if (!this->map_ptr->empty())
                 {
+                    _centerline_arc_lengths.clear();
+                    for (const auto &ll : this->map_ptr->laneletLayer)
+                    {
+                        _centerline_arc_lengths.emplace(ll.id(), build_centerline_arc_length(ll));
+                    }
                     return true;
                 }
             }
@@ -74,9 +98,118 @@ namespace message_services
             {
                 return false;
             }
+            build_lanelet_types_table();
             return true;
         }
 
+        bool message_lanelet2_translation::is_all_way_stop_entry(const lanelet::ConstLanelet &subj_lanelet)
+        {
+            for (const auto &reg : subj_lanelet.regulatoryElements())
+            {
+                if (reg->hasAttribute(lanelet::AttributeName::Subtype) && reg->attribute(lanelet::AttributeName::Subtype).value() == lanelet::AttributeValueString::AllWayStop)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::map<lanelet::Id, lanelet::Lanelet> message_lanelet2_translation::get_intersection_lanelets() const
+        {
+            std::map<lanelet::Id, lanelet::Lanelet> intersection_lanelets;
+            if (!this->vehicleGraph_ptr)
+            {
+                return intersection_lanelets;
+            }
+            for (auto &entry_lanelet : this->map_ptr->laneletLayer)
+            {
+                if (!is_all_way_stop_entry(entry_lanelet))
+                {
+                    continue;
+                }
+                intersection_lanelets.insert(std::make_pair(entry_lanelet.id(), entry_lanelet));
+                for (const auto &link_lanelet : vehicleGraph_ptr->following(entry_lanelet))
+                {
+                    intersection_lanelets.insert(std::make_pair(link_lanelet.id(), this->map_ptr->laneletLayer.get(link_lanelet.id())));
+                    for (const auto &departure_lanelet : vehicleGraph_ptr->following(link_lanelet))
+                    {
+                        intersection_lanelets.insert(std::make_pair(departure_lanelet.id(), this->map_ptr->laneletLayer.get(departure_lanelet.id())));
+                    }
+                }
+            }
+            return intersection_lanelets;
+        }
+
+        std::size_t message_lanelet2_translation::build_intersection_lanelet_index()
+        {
+            _grid_cells.clear();
+            _grid_cols = 0;
+            _grid_rows = 0;
+            if (!this->vehicleGraph_ptr)
+            {
+                return 0;
+            }
+
+            std::map<lanelet::Id, lanelet::Lanelet> intersection_lanelets = get_intersection_lanelets();
+            if (intersection_lanelets.empty())
+            {
+                return 0;
+            }
+
+            lanelet::BoundingBox2d grid_box;
+            for (const auto &id_lanelet : intersection_lanelets)
+            {
+                grid_box.extend(lanelet::geometry::boundingBox2d(id_lanelet.second));
+            }
+            // Grow cells for large intersections to bound the grid size
+            _grid_cell_size = std::max(_minimum_grid_cell_size, std::sqrt(grid_box.sizes().x() * grid_box.sizes().y() / _maximum_num_grid_cells));
+            _grid_origin = grid_box.min();
+            _grid_cols = static_cast<std::size_t>(grid_box.sizes().x() / _grid_cell_size) + 1;
+            _grid_rows = static_cast<std::size_t>(grid_box.sizes().y() / _grid_cell_size) + 1;
+            _grid_cells.resize(_grid_cols * _grid_rows);
+
+            for (const auto &id_lanelet : intersection_lanelets)
+            {
+                lanelet::BoundingBox2d lanelet_box = lanelet::geometry::boundingBox2d(id_lanelet.second);
+                auto min_col = static_cast<std::size_t>((lanelet_box.min().x() - _grid_origin.x()) / _grid_cell_size);
+                auto max_col = static_cast<std::size_t>((lanelet_box.max().x() - _grid_origin.x()) / _grid_cell_size);
+                auto min_row = static_cast<std::size_t>((lanelet_box.min().y() - _grid_origin.y()) / _grid_cell_size);
+                auto max_row = static_cast<std::size_t>((lanelet_box.max().y() - _grid_origin.y()) / _grid_cell_size);
+                for (std::size_t row = min_row; row <= max_row && row < _grid_rows; row++)
+                {
+                    for (std::size_t col = min_col; col <= max_col && col < _grid_cols; col++)
+                    {
+                        _grid_cells[row * _grid_cols + col].push_back(id_lanelet.second);
+                    }
+                }
+            }
+            SPDLOG_DEBUG("Intersection lanelet grid: {0} x {1} cells of {2} m", _grid_cols, _grid_rows, _grid_cell_size);
+            return intersection_lanelets.size();
+        }
+
+        std::vector<lanelet::Lanelet> message_lanelet2_translation::get_intersection_lanelets_by_point(const lanelet::BasicPoint2d &subj_point2d) const
+        {
+            std::vector<lanelet::Lanelet> containing_lanelets;
+            if (_grid_cells.empty())
+            {
+                return containing_lanelets;
+            }
+            double x = (subj_point2d.x() - _grid_origin.x()) / _grid_cell_size;
+            double y = (subj_point2d.y() - _grid_origin.y()) / _grid_cell_size;
+            if (x < 0 || y < 0 || x >= _grid_cols || y >= _grid_rows)
+            {
+                return containing_lanelets;
+            }
+            for (const auto &cell_lanelet : _grid_cells[static_cast<std::size_t>(y) * _grid_cols + static_cast<std::size_t>(x)])
+            {
+                if (lanelet::geometry::inside(cell_lanelet, subj_point2d))
+                {
+                    containing_lanelets.push_back(cell_lanelet);
+                }
+            }
+            return containing_lanelets;
+        }
+
         lanelet::Lanelet message_lanelet2_translation::get_cur_lanelet_by_loc_and_direction(double lat, double lon, double elev, std::string turn_direction, models::trajectory &trajectory) const
         {
             lanelet::BasicPoint3d subj_point3d = gps_2_map_point(lat, lon, elev);
@@ -88,6 +221,13 @@ namespace message_services
             std::vector<lanelet::Lanelet> current_total_lanelets;           
             lanelet::BasicPoint2d subj_point2d = lanelet::utils::to2D(subj_point3d);
 
+            // Points within the intersection do not need a search of the whole map
+            current_total_lanelets = get_intersection_lanelets_by_point(subj_point2d);
+            if (!current_total_lanelets.empty())
+            {
+                return current_total_lanelets;
+            }
+
             // Find the nearest lanelets with maximum number (=3) of return lanelets because a point in intersection may return maximum three link/bridge lanelets
             auto nearest_lanelets = lanelet::geometry::findNearest(this->map_ptr->laneletLayer, subj_point2d, 3);
 
@@ -204,49 +344,174 @@ namespace message_services
             return distance2_cur_lanelet_end(subj_point3d,subj_lanelet, turn_direction, trajectory);
         }
 
+        message_lanelet2_translation::centerline_arc_length_t message_lanelet2_translation::build_centerline_arc_length(const lanelet::ConstLanelet &subj_lanelet)
+        {
+            centerline_arc_length_t table;
+            auto centerline = subj_lanelet.centerline2d();
+            table.points.reserve(centerline.size());
+            table.arc_lengths.reserve(centerline.size());
+            double arc_length = 0.0;
+            for (const auto &point : centerline)
+            {
+                if (!table.points.empty())
+                {
+                    arc_length += (point.basicPoint() - table.points.back()).norm();
+                }
+                table.points.push_back(point.basicPoint());
+                table.arc_lengths.push_back(arc_length);
+            }
+            return table;
+        }
+
         double message_lanelet2_translation::distance2_cur_lanelet_end(lanelet::BasicPoint3d subj_point3d, lanelet::Lanelet subj_lanelet,std::string turn_direction, models::trajectory &trajectory) const
         {
-            double total_length = 0.0;
-            double p2p_d = -1;
-            bool start_accumulate = false;
             if (subj_lanelet.id() == lanelet::InvalId)
             {
                 SPDLOG_ERROR("Get invalid lanelet id = {0} from position: ({1}, {2} , {3}) and turn direction: {4}", subj_point3d.x(), subj_point3d.y(), subj_point3d.z(), turn_direction);
                 return -1;
             }
 
-            auto sub_lanelet_centerline = subj_lanelet.centerline2d();
-            lanelet::ConstHybridLineString2d lsHybrid = lanelet::utils::toHybrid(sub_lanelet_centerline);
+            // Lanelets that are not part of the loaded map have no precomputed table
+            centerline_arc_length_t local_table;
+            const centerline_arc_length_t *table = &local_table;
+            auto table_itr = _centerline_arc_lengths.find(subj_lanelet.id());
+            if (table_itr != _centerline_arc_lengths.end())
+            {
+                table = &table_itr->second;
+            }
+            else
+            {
+                local_table = build_centerline_arc_length(subj_lanelet);
+            }
+            const auto &points = table->points;
+            if (points.size() < 2)
+            {
+                return 0.0;
+            }
             lanelet::BasicPoint2d subj_point2d = lanelet::utils::to2D(subj_point3d);
 
-            // Get the distance between the subject point to the centerline.
-            auto dP2Line2d = lanelet::geometry::distance(subj_point2d, lsHybrid);
-            for (size_t i = 0; i < sub_lanelet_centerline.numSegments(); i++)
+            // Project the subject point onto the nearest centerline segment, the remaining length is read from the table
+            double min_distance2 = std::numeric_limits<double>::max();
+            std::size_t nearest_segment = 0;
+            double nearest_t = 0.0;
+            for (size_t i = 0; i + 1 < points.size(); i++)
             {
-                // Project the subject point to a point on the centerline                
-                if(!start_accumulate)
-                {
-                    p2p_d = lanelet::geometry::distance2d(subj_point2d, sub_lanelet_centerline.segment(i).first);
-                }
-                // Start from the closest point on the centerline to the subject point, and accumulate the closest point to the end of centerline
-                if (p2p_d != -1 && p2p_d <= (dP2Line2d + 0.2))
+                lanelet::BasicPoint2d segment = points[i + 1] - points[i];
+                double segment_length2 = segment.squaredNorm();
+                double t = segment_length2 > 0 ? std::clamp((subj_point2d - points[i]).dot(segment) / segment_length2, 0.0, 1.0) : 0.0;
+                double distance2 = (subj_point2d - (points[i] + t * segment)).squaredNorm();
+                if (distance2 < min_distance2)
                 {
-                    start_accumulate = true;
-                }
-
-                if (start_accumulate)
-                {
-                    double segment_distance = lanelet::geometry::distance2d(sub_lanelet_centerline.segment(i).first, sub_lanelet_centerline.segment(i).second);
-                    total_length += segment_distance;
+                    min_distance2 = distance2;
+                    nearest_segment = i;
+                    nearest_t = t;
                 }
             }
-            return total_length;
+            double segment_length = table->arc_lengths[nearest_segment + 1] - table->arc_lengths[nearest_segment];
+            return table->arc_lengths.back() - (table->arc_lengths[nearest_segment] + nearest_t * segment_length);
         }
 
         lanelet::BasicPoint3d message_lanelet2_translation::ecef_2_map_point(std::int32_t ecef_x, std::int32_t ecef_y, std::int32_t ecef_z) const
         {
-            lanelet::BasicPoint3d basic_point3d = this->local_projector->projectECEF({((double)ecef_x) / 100, ((double)ecef_y) / 100, ((double)ecef_z) / 100}, -1);
-            return basic_point3d;
+            return project_ecef({((double)ecef_x) / 100, ((double)ecef_y) / 100, ((double)ecef_z) / 100});
+        }
+
+        lanelet::BasicPoint3d message_lanelet2_translation::project_ecef_exact(const lanelet::BasicPoint3d &ecef_point) const
+        {
+            return this->local_projector->projectECEF(ecef_point, -1);
+        }
+
+        lanelet::BasicPoint3d message_lanelet2_translation::project_ecef(const lanelet::BasicPoint3d &ecef_point) const
+        {
+            lanelet::BasicPoint3d ecef_delta = ecef_point - _ecef_reference;
+            if (_is_linearized_projection && ecef_delta.norm() <= _linearized_projection_radius)
+            {
+                return _map_reference + _ecef_2_map_jacobian * ecef_delta;
+            }
+            return project_ecef_exact(ecef_point);
+        }
+
+        bool message_lanelet2_translation::init_linearized_projection(double radius, double max_error)
+        {
+            _is_linearized_projection = false;
+            if (radius <= 0 || !this->local_projector)
+            {
+                return false;
+            }
+
+            _map_reference = lanelet::BasicPoint3d(0, 0, 0);
+            if (!_grid_cells.empty())
+            {
+                _map_reference.x() = _grid_origin.x() + _grid_cols * _grid_cell_size / 2;
+                _map_reference.y() = _grid_origin.y() + _grid_rows * _grid_cell_size / 2;
+            }
+            lanelet::GPSPoint gps_reference = this->local_projector->reverse(_map_reference);
+            _ecef_reference = wgs84_2_ecef(gps_reference.lat, gps_reference.lon, gps_reference.ele);
+            _map_reference = project_ecef_exact(_ecef_reference);
+
+            // Central differences over 1 m along each ECEF axis
+            for (int axis = 0; axis < 3; axis++)
+            {
+                lanelet::BasicPoint3d step(0, 0, 0);
+                step[axis] = 0.5;
+                _ecef_2_map_jacobian.col(axis) = project_ecef_exact(_ecef_reference + step) - project_ecef_exact(_ecef_reference - step);
+            }
+
+            // Compare with the exact projection at radius around the reference. Ignoring the Earth curvature costs about
+            // radius^2 / (2 * Earth radius), largest in the horizontal plane spanned by the ECEF directions of the map x and y axes.
+            double max_deviation = 0;
+            lanelet::BasicPoint3d ecef_east = _ecef_2_map_jacobian.row(0).transpose().normalized();
+            lanelet::BasicPoint3d ecef_north = _ecef_2_map_jacobian.row(1).transpose().normalized();
+            lanelet::BasicPoint3d ecef_up = _ecef_2_map_jacobian.row(2).transpose().normalized();
+            std::vector<lanelet::BasicPoint3d> ecef_deltas = {radius * ecef_up, -radius * ecef_up};
+            const int horizontal_samples = 16;
+            for (int i = 0; i < horizontal_samples; i++)
+            {
+                double angle = 2 * M_PI * i / horizontal_samples;
+                ecef_deltas.push_back(radius * (std::cos(angle) * ecef_east + std::sin(angle) * ecef_north));
+            }
+            for (const auto &ecef_delta : ecef_deltas)
+            {
+                lanelet::BasicPoint3d linearized = _map_reference + _ecef_2_map_jacobian * ecef_delta;
+                max_deviation = std::max(max_deviation, (linearized - project_ecef_exact(_ecef_reference + ecef_delta)).norm());
+            }
+            if (max_deviation > max_error)
+            {
+                SPDLOG_WARN("Linearized projection deviates {0} m within {1} m of the intersection, above {2} m. Using exact projection.", max_deviation, radius, max_error);
+                return false;
+            }
+            SPDLOG_INFO("Linearized projection within {0} m of the intersection, maximum deviation {1} m.", radius, max_deviation);
+            _linearized_projection_radius = radius;
+            _is_linearized_projection = true;
+            return true;
+        }
+
+        std::vector<lanelet::BasicPoint3d> message_lanelet2_translation::trajectory_2_map_points(const models::trajectory &trajectory, const std::vector<std::size_t> &offset_indices) const
+        {
+            std::vector<lanelet::BasicPoint3d> map_points;
+            map_points.reserve(offset_indices.size() + 1);
+            // Cumulative offsets in centimeters, summed as integers like the senders do
+            std::int32_t ecef_x = trajectory.location.ecef_x;
+            std::int32_t ecef_y = trajectory.location.ecef_y;
+            std::int32_t ecef_z = trajectory.location.ecef_z;
+            map_points.push_back(ecef_2_map_point(ecef_x, ecef_y, ecef_z));
+            // Number of offsets summed so far
+            std::size_t summed = 0;
+            for (auto offset_index : offset_indices)
+            {
+                if (offset_index >= trajectory.offsets.size())
+                {
+                    break;
+                }
+                for (; summed <= offset_index; summed++)
+                {
+                    ecef_x += trajectory.offsets[summed].offset_x;
+                    ecef_y += trajectory.offsets[summed].offset_y;
+                    ecef_z += trajectory.offsets[summed].offset_z;
+                }
+                map_points.push_back(ecef_2_map_point(ecef_x, ecef_y, ecef_z));
+            }
+            return map_points;
         }
 
         lanelet::BasicPoint3d message_lanelet2_translation::gps_2_ecef(double lat, double lon, double elev) const {
@@ -275,104 +540,107 @@ namespace message_services
             return basic_point3d;            
         }
 
-        std::map<int64_t, models::intersection_lanelet_type> message_lanelet2_translation::get_lanelet_types_ids(lanelet::Lanelet subj_lanelet, std::string turn_direction) const
+        void message_lanelet2_translation::build_lanelet_types_table()
         {
-            std::map<int64_t, models::intersection_lanelet_type> lanelet_id_type_m;
-            if (subj_lanelet.id() == 0 )
+            _turn_direction_ids.clear();
+            _lanelet_types_table.clear();
+
+            // Turn direction id 0 is reserved for lanelets without turn direction and unknown turn directions
+            std::unordered_map<lanelet::Id, std::size_t> lanelet_turn_direction_ids;
+            for (const auto &ll : this->map_ptr->laneletLayer)
             {
-                SPDLOG_ERROR("Invalid start or end lanelet id. ");
-                return lanelet_id_type_m;
+                if (ll.hasAttribute("turn_direction"))
+                {
+                    auto itr = _turn_direction_ids.emplace(ll.attribute("turn_direction").value(), _turn_direction_ids.size() + 1).first;
+                    lanelet_turn_direction_ids.emplace(ll.id(), itr->second);
+                }
             }
+            auto turn_direction_id_of = [&lanelet_turn_direction_ids](const lanelet::ConstLanelet &ll)
+            {
+                auto itr = lanelet_turn_direction_ids.find(ll.id());
+                return itr == lanelet_turn_direction_ids.end() ? 0 : itr->second;
+            };
 
-                lanelet::ConstLanelet entry_lanelet;
-                lanelet::ConstLanelet link_lanelet;
-                lanelet::ConstLanelet departure_lanelet;
-                lanelet::Lanelet* ll_itr = &subj_lanelet;
+            // Only intersection lanelets have a non empty result, other lanelets are not in the table
+            for (const auto &id_lanelet : get_intersection_lanelets())
+            {
+                auto &types_by_turn_direction = _lanelet_types_table[id_lanelet.first];
+                types_by_turn_direction.resize(_turn_direction_ids.size() + 1);
+                for (std::size_t turn_direction_id = 0; turn_direction_id < types_by_turn_direction.size(); turn_direction_id++)
+                {
+                    types_by_turn_direction[turn_direction_id] = compute_lanelet_types_ids(id_lanelet.second, turn_direction_id, turn_direction_id_of);
+                }
+            }
+            SPDLOG_DEBUG("Built lanelet types table for {0} lanelets and {1} turn directions", _lanelet_types_table.size(), _turn_direction_ids.size());
+        }
+
+        std::map<int64_t, models::intersection_lanelet_type> message_lanelet2_translation::compute_lanelet_types_ids(const lanelet::ConstLanelet &subj_lanelet, std::size_t turn_direction_id,
+                                                                                                                    const std::function<std::size_t(const lanelet::ConstLanelet &)> &turn_direction_id_of) const
+        {
+            std::map<int64_t, models::intersection_lanelet_type> lanelet_id_type_m;
+            auto has_turn_direction = [&](const lanelet::ConstLanelet &ll)
+            {
+                return turn_direction_id != 0 && turn_direction_id_of(ll) == turn_direction_id;
+            };
+
+            lanelet::ConstLanelet entry_lanelet;
+            lanelet::ConstLanelet link_lanelet;
+            lanelet::ConstLanelet departure_lanelet;
             try
             {
-                    /** Checking whether the current lanelet is link lanelet.
-                     * The link lanelet's previous lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
-                     * **/
-                    lanelet::ConstLanelet local_ll = vehicleGraph_ptr->previous(*ll_itr).front();
-                    if (!local_ll.regulatoryElements().empty())
-                    {
-                        lanelet::RegulatoryElementConstPtrs reg_ptrs = local_ll.regulatoryElements();
-                        for (auto reg_ptrs_itr = reg_ptrs.begin(); reg_ptrs_itr != reg_ptrs.end(); reg_ptrs_itr++)
-                        {
-                            const lanelet::RegulatoryElement *reg = reg_ptrs_itr->get();
-                            if (reg->attribute(lanelet::AttributeName::Subtype).value() == lanelet::AttributeValueString::AllWayStop)
-                            {
-                                SPDLOG_DEBUG("Found link lanelet id :{0}  ", ll_itr->id());
-                                entry_lanelet = local_ll;
-                                link_lanelet = *ll_itr;
-                                departure_lanelet = vehicleGraph_ptr->following(link_lanelet).front();
-                                break;
-                            }
-                        }
-                    }
+                /** Checking whether the current lanelet is link lanelet.
+                 * The link lanelet's previous lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
+                 * **/
+                lanelet::ConstLanelets previous_lanelets = vehicleGraph_ptr->previous(subj_lanelet);
+                if (!previous_lanelets.empty() && is_all_way_stop_entry(previous_lanelets.front()))
+                {
+                    SPDLOG_TRACE("Found link lanelet id :{0}  ", subj_lanelet.id());
+                    lanelet::ConstLanelets following_lanelets = vehicleGraph_ptr->following(subj_lanelet);
+                    entry_lanelet = previous_lanelets.front();
+                    link_lanelet = subj_lanelet;
+                    departure_lanelet = following_lanelets.empty() ? lanelet::ConstLanelet() : following_lanelets.front();
+                }
 
-                    /***
-                     * Checking whether the current lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
-                     * **/
-                    if (!ll_itr->regulatoryElements().empty())
+                /***
+                 * Checking whether the current lanelet is entry lanelet, and entry lanelet has the all_way_stop regulatory element
+                 * **/
+                if (is_all_way_stop_entry(subj_lanelet))
+                {
+                    SPDLOG_TRACE("Found entry lanelet id :{0}  ", subj_lanelet.id());
+                    entry_lanelet = subj_lanelet;
+                    // Check turn_direction to determine the link lanelet for subject vehicle
+                    // If turn direction is "NA" or empty, it cannot determine which link lanelet inside the intersection
+                    for (const auto &possible_link : vehicleGraph_ptr->following(subj_lanelet))
                     {
-                        lanelet::RegulatoryElementPtrs reg_ptrs = ll_itr->regulatoryElements();
-                        for (auto reg_ptrs_itr = reg_ptrs.begin(); reg_ptrs_itr != reg_ptrs.end(); reg_ptrs_itr++)
+                        if (has_turn_direction(possible_link))
                         {
-                            const lanelet::RegulatoryElement *reg = reg_ptrs_itr->get();
-                            if (reg->attribute(lanelet::AttributeName::Subtype).value() == lanelet::AttributeValueString::AllWayStop)
-                            {
-                                SPDLOG_DEBUG("Found entry lanelet id :{0}  ", ll_itr->id());
-                                entry_lanelet = *ll_itr;
-                                lanelet::ConstLanelets possible_link_lanelets = vehicleGraph_ptr->following(*ll_itr);
-                                // Check turn_direction to determine the link lanelet for subject vehicle
-                                // If turn direction is "NA" or empty, it cannot determine which link lanelet inside the intersection
-                                for (auto itr = possible_link_lanelets.begin(); itr != possible_link_lanelets.end(); itr++)
-                                {
-                                    if (itr->hasAttribute("turn_direction") && itr->attribute("turn_direction").value() == turn_direction)
-                                    {
-                                        link_lanelet = *itr;
-                                        SPDLOG_DEBUG("Found link lanelet id :{0}  ", itr->id());
-                                        departure_lanelet = vehicleGraph_ptr->following(link_lanelet).front();
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    /**
-                     * Checking whether current lanelet is departure lanelet, previous lanelet will be link lanlet and the link lanelets
-                     * previous lanelet will be an entry lanelet that has the all_way_stop regulatory element
-                     * 
-                     */
-                    // Get possible link lanelets
-                    lanelet::ConstLanelets possible_links = vehicleGraph_ptr->previous(*ll_itr);
-                    lanelet::ConstLanelet possible_link;
-                    for ( const auto &lane : possible_links ) {
-                        if ( lane.hasAttribute("turn_direction") && lane.attribute("turn_direction").value() == turn_direction ) {
-                            possible_link = lane;
+                            SPDLOG_TRACE("Found link lanelet id :{0}  ", possible_link.id());
+                            lanelet::ConstLanelets following_lanelets = vehicleGraph_ptr->following(possible_link);
+                            link_lanelet = possible_link;
+                            departure_lanelet = following_lanelets.empty() ? lanelet::ConstLanelet() : following_lanelets.front();
                             break;
                         }
                     }
-                    if ( possible_link.id() != lanelet::InvalId ) {
-                        lanelet::ConstLanelet possible_entry = vehicleGraph_ptr->previous(possible_link).front();
-                        if (!possible_entry.regulatoryElements().empty())
+                }
+
+                /**
+                 * Checking whether current lanelet is departure lanelet, previous lanelet will be link lanlet and the link lanelets
+                 * previous lanelet will be an entry lanelet that has the all_way_stop regulatory element
+                 */
+                for (const auto &possible_link : previous_lanelets)
+                {
+                    if (has_turn_direction(possible_link))
+                    {
+                        lanelet::ConstLanelets possible_entries = vehicleGraph_ptr->previous(possible_link);
+                        if (!possible_entries.empty() && is_all_way_stop_entry(possible_entries.front()))
                         {
-                            lanelet::RegulatoryElementConstPtrs reg_ptrs = possible_entry.regulatoryElements();
-                            for (auto reg_ptrs_itr = reg_ptrs.begin(); reg_ptrs_itr != reg_ptrs.end(); reg_ptrs_itr++)
-                            {
-                                const lanelet::RegulatoryElement *reg = reg_ptrs_itr->get();
-                                if (reg->attribute(lanelet::AttributeName::Subtype).value() == lanelet::AttributeValueString::AllWayStop)
-                                {
-                                    entry_lanelet = possible_entry;
-                                    link_lanelet = possible_link;
-                                    departure_lanelet = *ll_itr;
-                                    break;
-                                }
-                            }
+                            entry_lanelet = possible_entries.front();
+                            link_lanelet = possible_link;
+                            departure_lanelet = subj_lanelet;
                         }
+                        break;
                     }
-
+                }
 
                 // insert the type for each lanelet id in the list of lanelet ids
                 if (entry_lanelet.id() != lanelet::InvalId)
@@ -389,9 +657,9 @@ namespace message_services
                 {
                     lanelet_id_type_m.insert(std::make_pair(departure_lanelet.id(), models::intersection_lanelet_type::departure));
                 }
-            return lanelet_id_type_m;
+                return lanelet_id_type_m;
             }
-            catch(const lanelet::LaneletError &e)
+            catch (const lanelet::LaneletError &e)
             {
                 SPDLOG_ERROR("Cannot determine lanelet type and ids with vehicle current lanelet. \n {0}", e.what());
                 lanelet_id_type_m.clear();
@@ -399,6 +667,24 @@ namespace message_services
             }
         }
 
+        std::map<int64_t, models::intersection_lanelet_type> message_lanelet2_translation::get_lanelet_types_ids(lanelet::Lanelet subj_lanelet, std::string turn_direction) const
+        {
+            if (subj_lanelet.id() == 0 )
+            {
+                SPDLOG_ERROR("Invalid start or end lanelet id. ");
+                return std::map<int64_t, models::intersection_lanelet_type>();
+            }
+
+            auto types_itr = _lanelet_types_table.find(subj_lanelet.id());
+            if (types_itr == _lanelet_types_table.end())
+            {
+                return std::map<int64_t, models::intersection_lanelet_type>();
+            }
+            auto turn_direction_itr = _turn_direction_ids.find(turn_direction);
+            std::size_t turn_direction_id = turn_direction_itr == _turn_direction_ids.end() ? 0 : turn_direction_itr->second;
+            return types_itr->second[turn_direction_id];
+        }
+
 
         lanelet::Lanelet message_lanelet2_translation::get_lanelet_by_id( const int lanelet_id)  const {
         return map_ptr->laneletLayer.get(lanelet_id);
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <spdlog/spdlog.h>
+
+#include "bsm.h"
+#include "mobilitypath.h"
+#include "mobilityoperation.h"
+
+namespace
+{
+    const std::string bsm_json_str = "{\"core_data\": {\"msg_count\": \"12\",\"id\": \"bsmid1\",\"sec_mark\": \"16323\",\"lat\": \"389562870\",\"long\": \"-771504920\",\"elev\": \"72\","
+                                     "\"accuracy\": {\"semi_major\": \"255\",\"semi_minor\": \"255\",\"orientation\": \"65535\"},\"transmission\": \"NEUTRAL\",\"speed\": \"1250\","
+                                     "\"heading\": \"12345\",\"angle\": \"127\",\"accel_set\": {\"long\": \"2001\",\"lat\": \"2001\",\"vert\": \"-127\",\"yaw\": \"0\"},"
+                                     "\"brakes\": {\"wheel_brakes\": \"00000\",\"traction\": \"0\",\"abs\": \"0\",\"scs\": \"0\",\"brake_boost\": \"0\",\"aux_brakes\": \"0\"},"
+                                     "\"size\": {\"width\": \"200\",\"length\": \"500\"}}}";
+    const std::string mo_json_str = "{\"metadata\": {\"hostStaticId\": \"DOT-507\",\"targetStaticId\": \"UNSET\",\"hostBSMId\": \"bsmid1\",\"planId\": \"00000000-0000-0000-0000-000000000000\",\"timestamp\": \"1632679657\"},"
+                                    "\"strategy\": \"Carma/stop_controlled_intersection\",\"strategy_params\": \"vehicle_id:DOT-507,msg_count:12,sec_mark:16323,access:0,max_accel:1.500000,max_decel:-1.000000,react_time:4.500000,min_gap:5.000000,depart_pos:0,turn_direction:straight\"}";
+
+    std::string mp_json_str()
+    {
+        std::string json_str = "{\"metadata\": {\"hostStaticId\": \"DOT-507\",\"targetStaticId\": \"UNSET\",\"hostBSMId\": \"bsmid1\",\"planId\": \"00000000-0000-0000-0000-000000000000\",\"timestamp\": \"1632679657\"},"
+                               "\"trajectory\": {\"location\": {\"ecefX\": 1105398,\"ecefY\": -4837961,\"ecefZ\": 3984453,\"timestamp\": \"1632679657\"},\"offsets\": [";
+        for (int i = 0; i < 60; i++)
+        {
+            json_str += (i == 0 ? "" : ",");
+            json_str += "{\"offsetX\": " + std::to_string(i) + ",\"offsetY\": " + std::to_string(-2 * i) + ",\"offsetZ\": 0}";
+        }
+        json_str += "]}}";
+        return json_str;
+    }
+
+    /**
+     * @brief Average decode time in nanoseconds of iterations calls to decode.
+     * **/
+    double run(int iterations, const std::function<bool()> &decode)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            if (!decode())
+            {
+                SPDLOG_CRITICAL("Decode failed in iteration {0}", i);
+                return 0;
+            }
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<double>(elapsed) / iterations;
+    }
+
+    template <typename Model>
+    void compare(const std::string &name, const std::string &json_str, int iterations)
+    {
+        // Decode into a new object each time, as the workers do. MobilityPath decoding appends to the current offsets.
+        auto dom_decode = [&]() { Model obj; return obj.baseMessage::fromJson(json_str); };
+        auto sax_decode = [&]() { Model obj; return obj.fromJson(json_str); };
+        // Warm up caches and the allocator before measuring
+        run(iterations / 10 + 1, dom_decode);
+        run(iterations / 10 + 1, sax_decode);
+        double dom_ns = run(iterations, dom_decode);
+        double sax_ns = run(iterations, sax_decode);
+        SPDLOG_INFO("{0}: {1} bytes, DOM {2:.0f} ns/msg, SAX {3:.0f} ns/msg, speedup {4:.2f}x", name, json_str.size(), dom_ns, sax_ns, sax_ns > 0 ? dom_ns / sax_ns : 0);
+    }
+}
+
+/**
+ * @brief Compare DOM (baseMessage::fromJson) and SAX (model fromJson) decoding of representative BSM, MobilityPath and
+ * MobilityOperation messages. Usage: message_decoder_benchmark [iterations, default 100000]
+ * **/
+int main(int argc, const char **argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (iterations <= 0)
+    {
+        SPDLOG_CRITICAL("Usage: message_decoder_benchmark [iterations]");
+        return 1;
+    }
+    compare<message_services::models::bsm>("bsm", bsm_json_str, iterations);
+    compare<message_services::models::mobilitypath>("mobilitypath", mp_json_str(), iterations);
+    compare<message_services::models::mobilityoperation>("mobilityoperation", mo_json_str, iterations);
+    return 0;
+}
@@ -6,17 +6,19 @@ namespace message_services
 
         std::string baseMessage::asJson() const
         {
-            rapidjson::StringBuffer ss;
-            rapidjson::Writer<rapidjson::StringBuffer> writer(ss);
+            std::string json;
+            json.reserve(JSON_RESERVE_SIZE);
+            string_output_stream os(json);
+            json_writer writer(os);
             if (this->asJsonObject(&writer))
-                return ss.GetString();
+                return json;
             return "";
         }
 
-        bool baseMessage::fromJson(const std::string &jsonString)
+        bool baseMessage::fromJson(std::string_view jsonString)
         {
             rapidjson::Document doc;
-            bool has_parse_error = doc.Parse(jsonString.c_str()).HasParseError() ? true : false;
+            bool has_parse_error = doc.Parse(jsonString.data(), jsonString.size()).HasParseError() ? true : false;
 
             if (has_parse_error)
             {
@@ -4,6 +4,7 @@
 
 #include <rapidjson/document.h>
 #include <string>
+#include <string_view>
 #include <rapidjson/istreamwrapper.h>
 #include <fstream>
 #include <rapidjson/stringbuffer.h>
@@ -20,14 +21,38 @@ namespace message_services
 
     namespace models
     {
+        /**
+         * @brief rapidjson output stream appending directly to a std::string. Serialized messages are built in the
+         * string that is handed to the kafka producer instead of being copied out of a rapidjson::StringBuffer.
+         */
+        class string_output_stream
+        {
+        public:
+            typedef char Ch;
+
+            explicit string_output_stream(std::string &str) : str_(str) {}
+
+            void Put(Ch c) { str_.push_back(c); }
+
+            void Flush() {}
+
+        private:
+            std::string &str_;
+        };
+
+        typedef rapidjson::Writer<string_output_stream> json_writer;
+
         class baseMessage
         {
         public:
-            virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const = 0;
+            // Initial capacity of the serialized string, avoids regrowing it while writing typical messages
+            static constexpr std::size_t JSON_RESERVE_SIZE = 1024;
+
+            virtual bool asJsonObject(json_writer *writer) const = 0;
 
             virtual std::string asJson() const;
 
-            virtual bool fromJson(const std::string &jsonString);
+            virtual bool fromJson(std::string_view jsonString);
 
             virtual void fromJsonObject(const rapidjson::Value &obj) = 0;
         };
@@ -4,12 +4,262 @@
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
 #include "bsm.h"
+#include "json_sax_decoder.h"
 
 namespace message_services
 {
 
     namespace models
     {
+        namespace
+        {
+            enum class bsm_scope
+            {
+                root,
+                core_data,
+                size,
+                accuracy,
+                accel_set,
+                brakes,
+                skip
+            };
+
+            enum class bsm_field
+            {
+                unknown,
+                core_data,
+                id,
+                angle,
+                sec_mark,
+                lat,
+                msg_count,
+                lon,
+                elev,
+                heading,
+                transmission,
+                speed,
+                size,
+                accuracy,
+                accel_set,
+                brakes,
+                length,
+                width,
+                orientation,
+                semi_major,
+                semi_minor,
+                accel_lat,
+                accel_long,
+                accel_vert,
+                accel_yaw,
+                abs,
+                aux_brakes,
+                brake_boost,
+                scs,
+                traction
+            };
+
+            /**
+             * @brief Streaming BSM decoder writing core data members straight into bsmCoreData_t. Accepts the same keys
+             * as bsm::fromJsonObject, core_data and the keys of its nested objects case insensitive.
+             */
+            class bsm_decoder : public json_sax_decoder<bsm_decoder, bsm_scope, bsm_field>
+            {
+            private:
+                bsm &_bsm;
+                bsmCoreData_t _core_data;
+
+            public:
+                explicit bsm_decoder(bsm &bsm_obj) : _bsm(bsm_obj) {}
+
+                bsm_field key_field(bsm_scope scope, std::string_view key) const
+                {
+                    switch (scope)
+                    {
+                    case bsm_scope::root:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("core_data"):
+                            return match_json_key(key, "core_data", bsm_field::core_data, true);
+                        }
+                        break;
+                    case bsm_scope::core_data:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("id"):
+                            return match_json_key(key, "id", bsm_field::id);
+                        case json_key_hash("angle"):
+                            return match_json_key(key, "angle", bsm_field::angle);
+                        case json_key_hash("sec_mark"):
+                            return match_json_key(key, "sec_mark", bsm_field::sec_mark);
+                        case json_key_hash("lat"):
+                            return match_json_key(key, "lat", bsm_field::lat);
+                        case json_key_hash("msg_count"):
+                            return match_json_key(key, "msg_count", bsm_field::msg_count);
+                        case json_key_hash("long"):
+                            return match_json_key(key, "long", bsm_field::lon);
+                        case json_key_hash("elev"):
+                            return match_json_key(key, "elev", bsm_field::elev);
+                        case json_key_hash("heading"):
+                            return match_json_key(key, "heading", bsm_field::heading);
+                        case json_key_hash("transmission"):
+                            return match_json_key(key, "transmission", bsm_field::transmission);
+                        case json_key_hash("speed"):
+                            return match_json_key(key, "speed", bsm_field::speed);
+                        case json_key_hash("size"):
+                            return match_json_key(key, "size", bsm_field::size);
+                        case json_key_hash("accuracy"):
+                            return match_json_key(key, "accuracy", bsm_field::accuracy);
+                        case json_key_hash("accel_set"):
+                            return match_json_key(key, "accel_set", bsm_field::accel_set);
+                        case json_key_hash("brakes"):
+                            return match_json_key(key, "brakes", bsm_field::brakes);
+                        }
+                        break;
+                    case bsm_scope::size:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("length"):
+                            return match_json_key(key, "length", bsm_field::length, true);
+                        case json_key_hash("width"):
+                            return match_json_key(key, "width", bsm_field::width, true);
+                        }
+                        break;
+                    case bsm_scope::accuracy:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("orientation"):
+                            return match_json_key(key, "orientation", bsm_field::orientation, true);
+                        case json_key_hash("semi_major"):
+                            return match_json_key(key, "semi_major", bsm_field::semi_major, true);
+                        case json_key_hash("semi_minor"):
+                            return match_json_key(key, "semi_minor", bsm_field::semi_minor, true);
+                        }
+                        break;
+                    case bsm_scope::accel_set:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("lat"):
+                            return match_json_key(key, "lat", bsm_field::accel_lat, true);
+                        case json_key_hash("long"):
+                            return match_json_key(key, "long", bsm_field::accel_long, true);
+                        case json_key_hash("vert"):
+                            return match_json_key(key, "vert", bsm_field::accel_vert, true);
+                        case json_key_hash("yaw"):
+                            return match_json_key(key, "yaw", bsm_field::accel_yaw, true);
+                        }
+                        break;
+                    case bsm_scope::brakes:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("abs"):
+                            return match_json_key(key, "abs", bsm_field::abs, true);
+                        case json_key_hash("aux_brakes"):
+                            return match_json_key(key, "aux_brakes", bsm_field::aux_brakes, true);
+                        case json_key_hash("brake_boost"):
+                            return match_json_key(key, "brake_boost", bsm_field::brake_boost, true);
+                        case json_key_hash("scs"):
+                            return match_json_key(key, "scs", bsm_field::scs, true);
+                        case json_key_hash("traction"):
+                            return match_json_key(key, "traction", bsm_field::traction, true);
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                    return bsm_field::unknown;
+                }
+
+                bsm_scope enter_object(bsm_scope, bsm_field field)
+                {
+                    switch (field)
+                    {
+                    case bsm_field::core_data:
+                        _core_data = bsmCoreData_t();
+                        return bsm_scope::core_data;
+                    case bsm_field::size:
+                        return bsm_scope::size;
+                    case bsm_field::accuracy:
+                        return bsm_scope::accuracy;
+                    case bsm_field::accel_set:
+                        return bsm_scope::accel_set;
+                    case bsm_field::brakes:
+                        return bsm_scope::brakes;
+                    default:
+                        return bsm_scope::skip;
+                    }
+                }
+
+                bsm_scope enter_array(bsm_scope, bsm_field) const
+                {
+                    return bsm_scope::skip;
+                }
+
+                void leave(bsm_scope scope)
+                {
+                    if (scope == bsm_scope::core_data)
+                    {
+                        _bsm.setCore_data(std::move(_core_data));
+                    }
+                }
+
+                bool value(bsm_scope, bsm_field field, const json_sax_value &value)
+                {
+                    switch (field)
+                    {
+                    case bsm_field::id:
+                        return value.get(_core_data.temprary_id);
+                    case bsm_field::angle:
+                        return value.get_as(_core_data.angle);
+                    case bsm_field::sec_mark:
+                        return value.get_as(_core_data.sec_mark);
+                    case bsm_field::lat:
+                        return value.get_as(_core_data.latitude);
+                    case bsm_field::msg_count:
+                        return value.get_as(_core_data.msg_count);
+                    case bsm_field::lon:
+                        return value.get_as(_core_data.longitude);
+                    case bsm_field::elev:
+                        return value.get_as(_core_data.elev);
+                    case bsm_field::heading:
+                        return value.get_as(_core_data.heading);
+                    case bsm_field::transmission:
+                        return value.get(_core_data.transmission);
+                    case bsm_field::speed:
+                        return value.get_as(_core_data.speed);
+                    case bsm_field::length:
+                        return value.get_as(_core_data.size.length);
+                    case bsm_field::width:
+                        return value.get_as(_core_data.size.width);
+                    case bsm_field::orientation:
+                        return value.get_as(_core_data.accuracy.orientation);
+                    case bsm_field::semi_major:
+                        return value.get_as(_core_data.accuracy.semiMajor);
+                    case bsm_field::semi_minor:
+                        return value.get_as(_core_data.accuracy.semiMinor);
+                    case bsm_field::accel_lat:
+                        return value.get_as(_core_data.accelSet.lat);
+                    case bsm_field::accel_long:
+                        return value.get_as(_core_data.accelSet.Long);
+                    case bsm_field::accel_vert:
+                        return value.get_as(_core_data.accelSet.vert);
+                    case bsm_field::accel_yaw:
+                        return value.get_as(_core_data.accelSet.yaw);
+                    case bsm_field::abs:
+                        return value.get_as(_core_data.brakes.abs);
+                    case bsm_field::aux_brakes:
+                        return value.get_as(_core_data.brakes.auxBrakes);
+                    case bsm_field::brake_boost:
+                        return value.get_as(_core_data.brakes.brakeBoost);
+                    case bsm_field::scs:
+                        return value.get_as(_core_data.brakes.scs);
+                    case bsm_field::traction:
+                        return value.get_as(_core_data.brakes.traction);
+                    default:
+                        return true;
+                    }
+                }
+            };
+        }
 
         bsm::bsm() : core_data()
         {
@@ -173,7 +423,13 @@ namespace message_services
             }
         }
 
-        bool bsm::asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const
+        bool bsm::fromJson(std::string_view jsonString)
+        {
+            bsm_decoder decoder(*this);
+            return decoder.decode(jsonString);
+        }
+
+        bool bsm::asJsonObject(json_writer *writer) const
         {
             try
             {
@@ -217,12 +473,10 @@ namespace message_services
             return out;
         }
 
-        std::string bsm::generate_hash_bsm_msg_id(std::string temprary_id, long msg_count, long sec_mark)
+        correlation_key_t bsm::get_bsm_msg_key() const
         {
-            std::stringstream hash_ss;
-            hash_ss << temprary_id << msg_count << sec_mark;
-            return hash_ss.str();
-        }      
+            return this->bsm_msg_key;
+        }
 
         bsmCoreData_t bsm::getCore_data() const
         {
@@ -232,6 +486,8 @@ namespace message_services
         void bsm::setCore_data(bsmCoreData_t core_data)
         {
             this->core_data = core_data;
+            this->bsm_msg_key = make_bsm_msg_key(pack_correlation_id(this->core_data.temprary_id), static_cast<uint32_t>(this->core_data.msg_count),
+                                                 static_cast<uint32_t>(this->core_data.sec_mark));
         }
 
     }
@@ -7,6 +7,7 @@
 #include <ctime>
 #include "baseMessage.h"
 #include "bsmCoreData.h"
+#include "correlation_key.h"
 
 namespace message_services
 {
@@ -18,6 +19,8 @@ namespace message_services
 
         private:
             bsmCoreData_t core_data;
+            // Key built from temporary id, msg_count and sec_mark when the core data is set
+            correlation_key_t bsm_msg_key;
 
         public:
             //constructors
@@ -27,14 +30,22 @@ namespace message_services
             virtual ~bsm();
             void setCore_data(bsmCoreData_t core_data);
             bsmCoreData_t getCore_data() const;
-            std::string generate_hash_bsm_msg_id( std::string temprary_id, long msg_count, long sec_mark);
+            /**
+             * @brief Key of this BSM referenced by MobilityOperation messages.
+             * **/
+            correlation_key_t get_bsm_msg_key() const;
 
             //Current timestamp in unit of milliseconds
             std::time_t msg_received_timestamp_ = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
             //json string object converter with rapidjson
+            /**
+             * @brief Decode a BSM with the rapidjson SAX reader without building a DOM.
+             * @return false if jsonString is not valid JSON or a core data member holds an invalid value
+             * **/
+            virtual bool fromJson(std::string_view jsonString);
             virtual void fromJsonObject(const rapidjson::Value &obj);
-            virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const;
+            virtual bool asJsonObject(json_writer *writer) const;
         };
     }
 
@@ -0,0 +1,89 @@
+#ifndef CORRELATION_KEY_H
+#define CORRELATION_KEY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace message_services
+{
+    namespace models
+    {
+        /**
+         * @brief Fixed width key correlating BSM, MobilityOperation and MobilityPath messages. id holds the packed
+         * BSM temporary id or sender id, value the msg_count and sec_mark or the timestamp bucket. Keys are built
+         * without allocation and compared and hashed as two integers.
+         */
+        typedef struct correlation_key
+        {
+            uint64_t id = 0;
+            uint64_t value = 0;
+
+            bool operator==(const correlation_key &other) const
+            {
+                return id == other.id && value == other.value;
+            }
+
+            bool operator!=(const correlation_key &other) const
+            {
+                return !(*this == other);
+            }
+        } correlation_key_t;
+
+        struct correlation_key_hash
+        {
+            std::size_t operator()(const correlation_key &key) const noexcept
+            {
+                // Mix both halves so keys differing only in value spread over the buckets
+                uint64_t hash = key.id ^ (key.value + 0x9E3779B97F4A7C15ULL + (key.id << 6) + (key.id >> 2));
+                hash ^= hash >> 33;
+                hash *= 0xFF51AFD7ED558CCDULL;
+                hash ^= hash >> 33;
+                return static_cast<std::size_t>(hash);
+            }
+        };
+
+        /**
+         * @brief Pack an id string into 64 bits. Ids of up to 8 characters (e.g. the hex BSM temporary id) are stored
+         * byte by byte and never collide. Longer ids are hashed with 64 bit FNV-1a and marked with the top bit, which
+         * is never set for packed ASCII ids.
+         */
+        inline uint64_t pack_correlation_id(std::string_view id)
+        {
+            if (id.size() <= sizeof(uint64_t))
+            {
+                uint64_t packed = 0;
+                for (std::size_t i = 0; i < id.size(); i++)
+                {
+                    packed |= static_cast<uint64_t>(static_cast<unsigned char>(id[i])) << (8 * i);
+                }
+                return packed;
+            }
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            for (char c : id)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001B3ULL;
+            }
+            return hash | (1ULL << 63);
+        }
+
+        /**
+         * @brief Key of a BSM, referenced by MobilityOperations through the BSM id, msg_count and sec_mark strategy params.
+         */
+        inline correlation_key make_bsm_msg_key(uint64_t packed_temporary_id, uint32_t msg_count, uint32_t sec_mark)
+        {
+            return {packed_temporary_id, (static_cast<uint64_t>(msg_count) << 32) | sec_mark};
+        }
+
+        /**
+         * @brief Key of a MobilityPath, referenced by MobilityOperations of the same sender within the same timestamp bucket.
+         */
+        inline correlation_key make_sender_timestamp_key(uint64_t packed_sender_id, uint64_t timestamp_bucket)
+        {
+            return {packed_sender_id, timestamp_bucket};
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef JSON_SAX_DECODER_H
+#define JSON_SAX_DECODER_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <boost/algorithm/string.hpp>
+#include "rapidjson/reader.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/encodedstream.h"
+
+namespace message_services
+{
+    namespace models
+    {
+        /**
+         * @brief Case insensitive 64 bit FNV-1a hash of an ASCII JSON key. Being constexpr it can be used as case label,
+         * so decoders dispatch on a key with a single switch. Known keys of a decoder must not collide, the matching
+         * case still compares the key to rule out unknown keys with the same hash.
+         */
+        constexpr uint64_t json_key_hash(std::string_view key)
+        {
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            for (char c : key)
+            {
+                hash ^= static_cast<unsigned char>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+                hash *= 0x100000001B3ULL;
+            }
+            return hash;
+        }
+
+        /**
+         * @brief Scalar JSON value as reported by the SAX reader. Message fields are sent as strings or numbers, the
+         * typed accessors accept both. String values point into the reader buffer and are null terminated.
+         */
+        struct json_sax_value
+        {
+            enum class kind
+            {
+                string_value,
+                int_value,
+                double_value
+            };
+            kind type = kind::string_value;
+            std::string_view str;
+            int64_t int_val = 0;
+            double double_val = 0;
+
+            bool get(std::string &value) const
+            {
+                if (type != kind::string_value)
+                {
+                    return false;
+                }
+                value.assign(str.data(), str.size());
+                return true;
+            }
+
+            bool get(int64_t &value) const
+            {
+                if (type == kind::int_value)
+                {
+                    value = int_val;
+                    return true;
+                }
+                if (type != kind::string_value || str.empty())
+                {
+                    return false;
+                }
+                char *parse_end = nullptr;
+                errno = 0;
+                long long parsed = std::strtoll(str.data(), &parse_end, 10);
+                if (errno != 0 || parse_end != str.data() + str.size())
+                {
+                    return false;
+                }
+                value = parsed;
+                return true;
+            }
+
+            bool get(double &value) const
+            {
+                if (type == kind::int_value)
+                {
+                    value = static_cast<double>(int_val);
+                    return true;
+                }
+                if (type == kind::double_value)
+                {
+                    value = double_val;
+                    return true;
+                }
+                if (type != kind::string_value || str.empty())
+                {
+                    return false;
+                }
+                char *parse_end = nullptr;
+                errno = 0;
+                double parsed = std::strtod(str.data(), &parse_end);
+                if (errno != 0 || parse_end != str.data() + str.size())
+                {
+                    return false;
+                }
+                value = parsed;
+                return true;
+            }
+
+            template <typename T>
+            bool get_as(T &value) const
+            {
+                typename std::conditional<std::is_integral<T>::value, int64_t, double>::type parsed;
+                if (!get(parsed))
+                {
+                    return false;
+                }
+                value = static_cast<T>(parsed);
+                return true;
+            }
+        };
+
+        /**
+         * @brief Base of the streaming message decoders. Tracks the nesting of objects and arrays as a stack of
+         * Derived::scope values and skips members the decoder does not know without building a DOM. Derived implements
+         *  - scope enum with members root and skip
+         *  - field enum with member unknown
+         *  - field key_field(scope, std::string_view key): field of key within scope
+         *  - scope enter_object(scope, field) and scope enter_array(scope, field): scope of a nested value of field
+         *  - void leave(scope): called when an object or array that was not skipped ends
+         *  - bool value(scope, field, const json_sax_value &): store the value of a known field, false fails the decode
+         */
+        template <typename Derived, typename Scope, typename Field>
+        class json_sax_decoder : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Derived>
+        {
+        private:
+            static constexpr std::size_t MAX_DEPTH = 16;
+            Scope _scopes[MAX_DEPTH];
+            std::size_t _depth = 0;
+            // Nesting below a skipped value
+            std::size_t _skip_depth = 0;
+            Field _field = Field::unknown;
+
+            Derived &derived()
+            {
+                return static_cast<Derived &>(*this);
+            }
+
+            bool on_value(const json_sax_value &value)
+            {
+                if (_skip_depth > 0 || _depth == 0 || _field == Field::unknown)
+                {
+                    return true;
+                }
+                Field field = _field;
+                _field = Field::unknown;
+                return derived().value(_scopes[_depth - 1], field, value);
+            }
+
+            bool enter(bool is_object)
+            {
+                if (_skip_depth > 0)
+                {
+                    _skip_depth++;
+                    return true;
+                }
+                Scope scope = Scope::root;
+                if (_depth > 0)
+                {
+                    scope = is_object ? derived().enter_object(_scopes[_depth - 1], _field)
+                                      : derived().enter_array(_scopes[_depth - 1], _field);
+                }
+                else if (!is_object)
+                {
+                    scope = Scope::skip;
+                }
+                _field = Field::unknown;
+                if (scope == Scope::skip || _depth == MAX_DEPTH)
+                {
+                    _skip_depth = 1;
+                    return true;
+                }
+                _scopes[_depth++] = scope;
+                return true;
+            }
+
+            bool leave_scope()
+            {
+                if (_skip_depth > 0)
+                {
+                    _skip_depth--;
+                    return true;
+                }
+                if (_depth == 0)
+                {
+                    return false;
+                }
+                derived().leave(_scopes[--_depth]);
+                _field = Field::unknown;
+                return true;
+            }
+
+        public:
+            /**
+             * @brief Decode json_str with the SAX reader.
+             * @return false if json_str is not valid JSON or a known field holds an invalid value
+             * **/
+            bool decode(std::string_view json_str)
+            {
+                rapidjson::MemoryStream ms(json_str.data(), json_str.size());
+                rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> is(ms);
+                rapidjson::Reader reader;
+                return !reader.Parse(is, derived()).IsError();
+            }
+
+            bool Key(const char *str, rapidjson::SizeType length, bool)
+            {
+                if (_skip_depth == 0 && _depth > 0)
+                {
+                    _field = derived().key_field(_scopes[_depth - 1], std::string_view(str, length));
+                }
+                return true;
+            }
+
+            bool String(const char *str, rapidjson::SizeType length, bool)
+            {
+                json_sax_value value;
+                value.type = json_sax_value::kind::string_value;
+                value.str = std::string_view(str, length);
+                return on_value(value);
+            }
+
+            bool Int(int i) { return Int64(i); }
+            bool Uint(unsigned u) { return Int64(u); }
+            bool Int64(int64_t i)
+            {
+                json_sax_value value;
+                value.type = json_sax_value::kind::int_value;
+                value.int_val = i;
+                return on_value(value);
+            }
+            bool Uint64(uint64_t u)
+            {
+                json_sax_value value;
+                value.type = json_sax_value::kind::int_value;
+                value.int_val = static_cast<int64_t>(u);
+                return on_value(value);
+            }
+            bool Double(double d)
+            {
+                json_sax_value value;
+                value.type = json_sax_value::kind::double_value;
+                value.double_val = d;
+                return on_value(value);
+            }
+            // Fields of the decoded messages are never null or boolean, such values are ignored like unknown keys
+            bool Null()
+            {
+                _field = Field::unknown;
+                return true;
+            }
+            bool Bool(bool)
+            {
+                _field = Field::unknown;
+                return true;
+            }
+
+            bool StartObject() { return enter(true); }
+            bool EndObject(rapidjson::SizeType) { return leave_scope(); }
+            bool StartArray() { return enter(false); }
+            bool EndArray(rapidjson::SizeType) { return leave_scope(); }
+        };
+
+        /**
+         * @brief Field of key if it matches expected, the hash of key already matched the case label of expected.
+         * **/
+        template <typename Field>
+        Field match_json_key(std::string_view key, std::string_view expected, Field field, bool ignore_case = false)
+        {
+            bool is_match = ignore_case ? boost::iequals(key, expected) : key == expected;
+            return is_match ? field : Field::unknown;
+        }
+    }
+}
+
+#endif
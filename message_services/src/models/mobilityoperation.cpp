@@ -1,15 +1,145 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdint>
 
 #include <boost/algorithm/string.hpp>
 #include "mobilityoperation.h"
+#include "json_sax_decoder.h"
 
 namespace message_services
 {
 
     namespace models
     {
+        namespace
+        {
+            enum class mobilityoperation_scope
+            {
+                root,
+                metadata,
+                skip
+            };
+
+            enum class mobilityoperation_field
+            {
+                unknown,
+                metadata,
+                strategy,
+                strategy_params,
+                host_static_id,
+                host_bsm_id,
+                plan_id,
+                target_static_id,
+                timestamp
+            };
+
+            /**
+             * @brief Streaming MobilityOperation decoder. Accepts the same keys as mobilityoperation::fromJsonObject.
+             */
+            class mobilityoperation_decoder : public json_sax_decoder<mobilityoperation_decoder, mobilityoperation_scope, mobilityoperation_field>
+            {
+            private:
+                mobilityoperation &_mo;
+                mobility_header_t _header;
+
+            public:
+                explicit mobilityoperation_decoder(mobilityoperation &mo_obj) : _mo(mo_obj) {}
+
+                mobilityoperation_field key_field(mobilityoperation_scope scope, std::string_view key) const
+                {
+                    switch (scope)
+                    {
+                    case mobilityoperation_scope::root:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("metadata"):
+                            return match_json_key(key, "metadata", mobilityoperation_field::metadata, true);
+                        case json_key_hash("strategy"):
+                            return match_json_key(key, "strategy", mobilityoperation_field::strategy, true);
+                        case json_key_hash("strategy_params"):
+                            return match_json_key(key, "strategy_params", mobilityoperation_field::strategy_params, true);
+                        }
+                        break;
+                    case mobilityoperation_scope::metadata:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("hostStaticId"):
+                            return match_json_key(key, "hostStaticId", mobilityoperation_field::host_static_id);
+                        case json_key_hash("hostBSMId"):
+                            return match_json_key(key, "hostBSMId", mobilityoperation_field::host_bsm_id);
+                        case json_key_hash("planId"):
+                            return match_json_key(key, "planId", mobilityoperation_field::plan_id);
+                        case json_key_hash("targetStaticId"):
+                            return match_json_key(key, "targetStaticId", mobilityoperation_field::target_static_id);
+                        case json_key_hash("timestamp"):
+                            return match_json_key(key, "timestamp", mobilityoperation_field::timestamp);
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                    return mobilityoperation_field::unknown;
+                }
+
+                mobilityoperation_scope enter_object(mobilityoperation_scope, mobilityoperation_field field)
+                {
+                    if (field == mobilityoperation_field::metadata)
+                    {
+                        _header = mobility_header_t();
+                        return mobilityoperation_scope::metadata;
+                    }
+                    return mobilityoperation_scope::skip;
+                }
+
+                mobilityoperation_scope enter_array(mobilityoperation_scope, mobilityoperation_field) const
+                {
+                    return mobilityoperation_scope::skip;
+                }
+
+                void leave(mobilityoperation_scope scope)
+                {
+                    if (scope == mobilityoperation_scope::metadata)
+                    {
+                        _mo.setHeader(std::move(_header));
+                    }
+                }
+
+                bool value(mobilityoperation_scope, mobilityoperation_field field, const json_sax_value &value)
+                {
+                    switch (field)
+                    {
+                    case mobilityoperation_field::strategy:
+                        // Non string strategy and strategy params are ignored like in fromJsonObject
+                        if (value.type == json_sax_value::kind::string_value)
+                        {
+                            _mo.setStrategy(std::string(value.str));
+                        }
+                        return true;
+                    case mobilityoperation_field::strategy_params:
+                        if (value.type == json_sax_value::kind::string_value)
+                        {
+                            _mo.setStrategy_params(std::string(value.str));
+                        }
+                        return true;
+                    case mobilityoperation_field::host_static_id:
+                        return value.get(_header.sender_id);
+                    case mobilityoperation_field::host_bsm_id:
+                        return value.get(_header.sender_bsm_id);
+                    case mobilityoperation_field::plan_id:
+                        return value.get(_header.plan_id);
+                    case mobilityoperation_field::target_static_id:
+                        return value.get(_header.recipient_id);
+                    case mobilityoperation_field::timestamp:
+                        return value.get_as(_header.timestamp);
+                    default:
+                        return true;
+                    }
+                }
+            };
+        }
 
         mobilityoperation::mobilityoperation() : strategy(""), strategy_params(""), header()
         {
@@ -19,18 +149,21 @@ namespace message_services
         {
         }
 
-        std::string mobilityoperation::generate_hash_sender_timestamp_id(std::string sender_bsm_id, uint64_t timestamp)
+        bool mobilityoperation::get_bsm_msg_key(correlation_key_t &key) const
         {
-            std::stringstream hash_ss;
-            hash_ss << sender_bsm_id << timestamp;
-            return hash_ss.str();
+            if (!this->has_bsm_msg_count)
+            {
+                return false;
+            }
+            key = make_bsm_msg_key(this->packed_sender_bsm_id, this->bsm_msg_count, this->bsm_sec_mark);
+            return true;
         }
-        std::string mobilityoperation::generate_hash_bsm_msg_id(std::string temprary_id, long msg_count, long sec_mark)
+
+        correlation_key_t mobilityoperation::get_sender_timestamp_key(uint64_t timestamp_bucket_duration) const
         {
-            std::stringstream hash_ss;
-            hash_ss << temprary_id << msg_count << sec_mark;
-            return hash_ss.str();
+            return make_sender_timestamp_key(this->packed_sender_id, this->header.timestamp / timestamp_bucket_duration);
         }
+
         void mobilityoperation::fromJsonObject(const rapidjson::Value &obj)
         {
             if (obj.IsObject())
@@ -85,7 +218,13 @@ namespace message_services
             }
         }
 
-        bool mobilityoperation::asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const
+        bool mobilityoperation::fromJson(std::string_view jsonString)
+        {
+            mobilityoperation_decoder decoder(*this);
+            return decoder.decode(jsonString);
+        }
+
+        bool mobilityoperation::asJsonObject(json_writer *writer) const
         {
             try
             {
@@ -115,37 +254,123 @@ namespace message_services
             }
         }
 
-        std::string mobilityoperation::get_value_from_strategy_params(std::string key) const
+        namespace
         {
-            const char *delimiter = ",:";
-            std::string key_value_str = "";
-            std::vector<std::string> key_value_v = {};
-            std::stringstream strategy_params_stream(this->strategy_params);
-            // strategy_params are key value pairs separate by comma
-            while (std::getline(strategy_params_stream, key_value_str, *delimiter))
+            bool is_strategy_params_space(char c)
             {
-                std::stringstream key_value_str_stream(key_value_str);
-                std::string key_or_value = "";
+                return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+            }
 
-                while (std::getline(key_value_str_stream, key_or_value, *(delimiter + 1)))
+            // Trim whitespace from both ends of [pos, end) of str
+            void trim_strategy_params_range(const std::string &str, std::size_t pos, std::size_t end, uint32_t &trimmed_pos, uint32_t &trimmed_len)
+            {
+                while (pos < end && is_strategy_params_space(str[pos]))
+                {
+                    pos++;
+                }
+                while (end > pos && is_strategy_params_space(str[end - 1]))
                 {
-                    boost::algorithm::trim(key_or_value);
-                    key_value_v.push_back(key_or_value);
+                    end--;
                 }
+                trimmed_pos = static_cast<uint32_t>(pos);
+                trimmed_len = static_cast<uint32_t>(end - pos);
+            }
+        }
 
-                if (key_value_v.size() > 0 && key_value_v.front() == key)
+        void mobilityoperation::index_strategy_params()
+        {
+            // strategy_params are key value pairs separated by comma, key and value are separated by colon
+            this->strategy_params_index.clear();
+            std::size_t pair_pos = 0;
+            while (pair_pos < this->strategy_params.size())
+            {
+                std::size_t pair_end = this->strategy_params.find(',', pair_pos);
+                if (pair_end == std::string::npos)
                 {
-                    return key_value_v.back();
+                    pair_end = this->strategy_params.size();
+                }
+                std::size_t key_end = this->strategy_params.find(':', pair_pos);
+                if (key_end == std::string::npos || key_end > pair_end)
+                {
+                    key_end = pair_end;
+                }
+                // The value is the text after the last colon of the pair
+                std::size_t value_pos = pair_pos;
+                for (std::size_t pos = pair_end; pos > key_end; pos--)
+                {
+                    if (this->strategy_params[pos - 1] == ':')
+                    {
+                        value_pos = pos;
+                        break;
+                    }
                 }
 
-                if (key_value_v.size() > 0)
+                strategy_param_range_t range;
+                trim_strategy_params_range(this->strategy_params, pair_pos, key_end, range.key_pos, range.key_len);
+                trim_strategy_params_range(this->strategy_params, value_pos, pair_end, range.value_pos, range.value_len);
+                if (range.key_len > 0)
                 {
-                    key_value_v.clear();
+                    this->strategy_params_index.push_back(range);
                 }
+                pair_pos = pair_end + 1;
+            }
+        }
 
-                key_value_str = "";
+        bool mobilityoperation::find_strategy_param(std::string_view key, std::string_view &value) const
+        {
+            std::string_view params(this->strategy_params);
+            for (const auto &range : this->strategy_params_index)
+            {
+                if (params.substr(range.key_pos, range.key_len) == key)
+                {
+                    value = params.substr(range.value_pos, range.value_len);
+                    return true;
+                }
             }
-            return key_value_str;
+            return false;
+        }
+
+        bool mobilityoperation::get_strategy_param(std::string_view key, long &value) const
+        {
+            std::string_view value_str;
+            if (!find_strategy_param(key, value_str) || value_str.empty())
+            {
+                return false;
+            }
+            // Values are views into the null terminated strategy_params, so strtol stops at the end of the string at the latest
+            char *parse_end = nullptr;
+            errno = 0;
+            long parsed = std::strtol(value_str.data(), &parse_end, 10);
+            if (errno != 0 || parse_end != value_str.data() + value_str.size())
+            {
+                return false;
+            }
+            value = parsed;
+            return true;
+        }
+
+        bool mobilityoperation::get_strategy_param(std::string_view key, double &value) const
+        {
+            std::string_view value_str;
+            if (!find_strategy_param(key, value_str) || value_str.empty())
+            {
+                return false;
+            }
+            char *parse_end = nullptr;
+            errno = 0;
+            double parsed = std::strtod(value_str.data(), &parse_end);
+            if (errno != 0 || parse_end != value_str.data() + value_str.size())
+            {
+                return false;
+            }
+            value = parsed;
+            return true;
+        }
+
+        std::string mobilityoperation::get_value_from_strategy_params(std::string key) const
+        {
+            std::string_view value;
+            return find_strategy_param(key, value) ? std::string(value) : std::string();
         }
 
         std::ostream &operator<<(std::ostream &out, mobilityoperation &mobilityoperation_obj)
@@ -167,6 +392,8 @@ namespace message_services
         void mobilityoperation::setHeader(mobility_header_t header)
         {
             this->header = header;
+            this->packed_sender_id = pack_correlation_id(this->header.sender_id);
+            this->packed_sender_bsm_id = pack_correlation_id(this->header.sender_bsm_id);
         }
         std::string mobilityoperation::getStrategy_params() const
         {
@@ -175,6 +402,13 @@ namespace message_services
         void mobilityoperation::setStrategy_params(std::string strategy_params)
         {
             this->strategy_params = strategy_params;
+            index_strategy_params();
+            long msg_count = 0;
+            long sec_mark = 0;
+            this->has_bsm_msg_count = get_strategy_param("msg_count", msg_count) && get_strategy_param("sec_mark", sec_mark) &&
+                                      msg_count >= 0 && msg_count <= UINT32_MAX && sec_mark >= 0 && sec_mark <= UINT32_MAX;
+            this->bsm_msg_count = this->has_bsm_msg_count ? static_cast<uint32_t>(msg_count) : 0;
+            this->bsm_sec_mark = this->has_bsm_msg_count ? static_cast<uint32_t>(sec_mark) : 0;
         }
         std::string mobilityoperation::getStrategy() const
         {
@@ -4,15 +4,29 @@
 
 #include <spdlog/spdlog.h>
 #include <iomanip>
+#include <string_view>
 
 #include "baseMessage.h"
 #include "mobilityHeader.h"
+#include "correlation_key.h"
 namespace message_services
 {
 
     namespace models
     {
 
+        /**
+         * @brief Position of a key value pair within the strategy_params string. Offsets rather than views keep the
+         * index valid when the MobilityOperation is copied or moved.
+         */
+        typedef struct strategy_param_range
+        {
+            uint32_t key_pos = 0;
+            uint32_t key_len = 0;
+            uint32_t value_pos = 0;
+            uint32_t value_len = 0;
+        } strategy_param_range_t;
+
         class mobilityoperation : public baseMessage
         {
             friend std::ostream &operator<<(std::ostream &out, mobilityoperation &mobilityoperation_obj);
@@ -21,6 +35,19 @@ namespace message_services
             mobility_header_t header;
             std::string strategy = "";
             std::string strategy_params = "";
+            // Key value pairs of strategy_params, built once when the strategy params are set
+            std::vector<strategy_param_range_t> strategy_params_index;
+            // Correlation key parts extracted when the header and strategy params are set
+            uint64_t packed_sender_id = 0;
+            uint64_t packed_sender_bsm_id = 0;
+            bool has_bsm_msg_count = false;
+            uint32_t bsm_msg_count = 0;
+            uint32_t bsm_sec_mark = 0;
+
+            /**
+             * @brief Split strategy_params into strategy_params_index.
+             * **/
+            void index_strategy_params();
 
         public:
             mobilityoperation(/* args */);
@@ -29,14 +56,45 @@ namespace message_services
             //Current timestamp in unit of milliseconds
             std::time_t msg_received_timestamp_ = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
+            /**
+             * @brief Decode a MobilityOperation with the rapidjson SAX reader without building a DOM.
+             * @return false if jsonString is not valid JSON or a header member holds an invalid value
+             * **/
+            virtual bool fromJson(std::string_view jsonString);
             virtual void fromJsonObject(const rapidjson::Value &obj);
-            virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const;
+            virtual bool asJsonObject(json_writer *writer) const;
 
+            /**
+             * @brief Value of key in the strategy params, e.g. "12" for key "msg_count" in "msg_count: 12, access: 0".
+             * @return the value or an empty string if the strategy params do not contain key
+             * **/
             std::string get_value_from_strategy_params(std::string key) const;
 
-            std::string generate_hash_bsm_msg_id( std::string temprary_id, long msg_count, long sec_mark);
-
-            std::string generate_hash_sender_timestamp_id( std::string sender_bsm_id, uint64_t timestamp );
+            /**
+             * @brief Look up the value of key in the strategy params index without copying it.
+             * @param value view into the strategy params, valid until the strategy params are set again
+             * @return false if the strategy params do not contain key
+             * **/
+            bool find_strategy_param(std::string_view key, std::string_view &value) const;
+            /**
+             * @brief Typed strategy param accessors. The whole value has to be a valid number.
+             * @return false if the strategy params do not contain key or its value is not a valid number
+             * **/
+            bool get_strategy_param(std::string_view key, long &value) const;
+            bool get_strategy_param(std::string_view key, double &value) const;
+
+            /**
+             * @brief Key of the BSM this MobilityOperation refers to by BSM id and the msg_count and sec_mark strategy params.
+             * @param key of the referenced BSM
+             * @return false if the strategy params do not contain a valid msg_count and sec_mark
+             * **/
+            bool get_bsm_msg_key(correlation_key_t &key) const;
+
+            /**
+             * @brief Key of the MobilityPath this MobilityOperation refers to by sender id and timestamp.
+             * @param timestamp_bucket_duration duration in milliseconds of the timestamp buckets MobilityOperation and MobilityPath are matched in
+             * **/
+            correlation_key_t get_sender_timestamp_key(uint64_t timestamp_bucket_duration) const;
 
             std::string getStrategy_params() const;
             void setStrategy_params(std::string strategy_params);
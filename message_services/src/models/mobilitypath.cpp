@@ -3,12 +3,204 @@
 #include <boost/algorithm/string.hpp>
 
 #include "mobilitypath.h"
+#include "json_sax_decoder.h"
 
 namespace message_services
 {
 
     namespace models
     {
+        namespace
+        {
+            enum class mobilitypath_scope
+            {
+                root,
+                metadata,
+                trajectory,
+                location,
+                offsets,
+                offset,
+                skip
+            };
+
+            enum class mobilitypath_field
+            {
+                unknown,
+                metadata,
+                trajectory,
+                host_static_id,
+                target_static_id,
+                host_bsm_id,
+                plan_id,
+                timestamp,
+                location,
+                offsets,
+                ecef_x,
+                ecef_y,
+                ecef_z,
+                offset_x,
+                offset_y,
+                offset_z
+            };
+
+            /**
+             * @brief Streaming MobilityPath decoder appending trajectory offsets straight into trajectory_t. Accepts the
+             * same keys as mobilitypath::fromJsonObject.
+             */
+            class mobilitypath_decoder : public json_sax_decoder<mobilitypath_decoder, mobilitypath_scope, mobilitypath_field>
+            {
+            private:
+                mobilitypath &_mp;
+                mobility_header_t _header;
+                trajectory_t _trajectory;
+
+            public:
+                explicit mobilitypath_decoder(mobilitypath &mp_obj) : _mp(mp_obj) {}
+
+                mobilitypath_field key_field(mobilitypath_scope scope, std::string_view key) const
+                {
+                    switch (scope)
+                    {
+                    case mobilitypath_scope::root:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("metadata"):
+                            return match_json_key(key, "metadata", mobilitypath_field::metadata, true);
+                        case json_key_hash("trajectory"):
+                            return match_json_key(key, "trajectory", mobilitypath_field::trajectory, true);
+                        }
+                        break;
+                    case mobilitypath_scope::metadata:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("hostStaticId"):
+                            return match_json_key(key, "hostStaticId", mobilitypath_field::host_static_id);
+                        case json_key_hash("targetStaticId"):
+                            return match_json_key(key, "targetStaticId", mobilitypath_field::target_static_id);
+                        case json_key_hash("hostBSMId"):
+                            return match_json_key(key, "hostBSMId", mobilitypath_field::host_bsm_id);
+                        case json_key_hash("planId"):
+                            return match_json_key(key, "planId", mobilitypath_field::plan_id);
+                        case json_key_hash("timestamp"):
+                            return match_json_key(key, "timestamp", mobilitypath_field::timestamp);
+                        }
+                        break;
+                    case mobilitypath_scope::trajectory:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("location"):
+                            return match_json_key(key, "location", mobilitypath_field::location, true);
+                        case json_key_hash("offsets"):
+                            return match_json_key(key, "offsets", mobilitypath_field::offsets, true);
+                        }
+                        break;
+                    case mobilitypath_scope::location:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("ecefX"):
+                            return match_json_key(key, "ecefX", mobilitypath_field::ecef_x);
+                        case json_key_hash("ecefY"):
+                            return match_json_key(key, "ecefY", mobilitypath_field::ecef_y);
+                        case json_key_hash("ecefZ"):
+                            return match_json_key(key, "ecefZ", mobilitypath_field::ecef_z);
+                        case json_key_hash("timestamp"):
+                            return match_json_key(key, "timestamp", mobilitypath_field::timestamp);
+                        }
+                        break;
+                    case mobilitypath_scope::offset:
+                        switch (json_key_hash(key))
+                        {
+                        case json_key_hash("offsetX"):
+                            return match_json_key(key, "offsetX", mobilitypath_field::offset_x);
+                        case json_key_hash("offsetY"):
+                            return match_json_key(key, "offsetY", mobilitypath_field::offset_y);
+                        case json_key_hash("offsetZ"):
+                            return match_json_key(key, "offsetZ", mobilitypath_field::offset_z);
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                    return mobilitypath_field::unknown;
+                }
+
+                mobilitypath_scope enter_object(mobilitypath_scope scope, mobilitypath_field field)
+                {
+                    if (scope == mobilitypath_scope::offsets)
+                    {
+                        _trajectory.offsets.emplace_back();
+                        return mobilitypath_scope::offset;
+                    }
+                    switch (field)
+                    {
+                    case mobilitypath_field::metadata:
+                        _header = mobility_header_t();
+                        return mobilitypath_scope::metadata;
+                    case mobilitypath_field::trajectory:
+                        // Like fromJsonObject, trajectory members are added to the current trajectory
+                        _trajectory = _mp.getTrajectory();
+                        return mobilitypath_scope::trajectory;
+                    case mobilitypath_field::location:
+                        return mobilitypath_scope::location;
+                    default:
+                        return mobilitypath_scope::skip;
+                    }
+                }
+
+                mobilitypath_scope enter_array(mobilitypath_scope, mobilitypath_field field)
+                {
+                    if (field == mobilitypath_field::offsets)
+                    {
+                        _trajectory.offsets.reserve(_trajectory.offsets.size() + _trajectory.MAX_POINTS_IN_MESSAGE);
+                        return mobilitypath_scope::offsets;
+                    }
+                    return mobilitypath_scope::skip;
+                }
+
+                void leave(mobilitypath_scope scope)
+                {
+                    if (scope == mobilitypath_scope::metadata)
+                    {
+                        _mp.setHeader(std::move(_header));
+                    }
+                    else if (scope == mobilitypath_scope::trajectory)
+                    {
+                        _mp.setTrajectory(std::move(_trajectory));
+                    }
+                }
+
+                bool value(mobilitypath_scope scope, mobilitypath_field field, const json_sax_value &value)
+                {
+                    switch (field)
+                    {
+                    case mobilitypath_field::host_static_id:
+                        return value.get(_header.sender_id);
+                    case mobilitypath_field::target_static_id:
+                        return value.get(_header.recipient_id);
+                    case mobilitypath_field::host_bsm_id:
+                        return value.get(_header.sender_bsm_id);
+                    case mobilitypath_field::plan_id:
+                        return value.get(_header.plan_id);
+                    case mobilitypath_field::timestamp:
+                        return scope == mobilitypath_scope::location ? value.get_as(_trajectory.location.timestamp) : value.get_as(_header.timestamp);
+                    case mobilitypath_field::ecef_x:
+                        return value.get_as(_trajectory.location.ecef_x);
+                    case mobilitypath_field::ecef_y:
+                        return value.get_as(_trajectory.location.ecef_y);
+                    case mobilitypath_field::ecef_z:
+                        return value.get_as(_trajectory.location.ecef_z);
+                    case mobilitypath_field::offset_x:
+                        return value.get_as(_trajectory.offsets.back().offset_x);
+                    case mobilitypath_field::offset_y:
+                        return value.get_as(_trajectory.offsets.back().offset_y);
+                    case mobilitypath_field::offset_z:
+                        return value.get_as(_trajectory.offsets.back().offset_z);
+                    default:
+                        return true;
+                    }
+                }
+            };
+        }
 
         mobilitypath::mobilitypath() : header(), trajectory() {}
 
@@ -116,7 +308,13 @@ namespace message_services
             }
         }
 
-        bool mobilitypath::asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const
+        bool mobilitypath::fromJson(std::string_view jsonString)
+        {
+            mobilitypath_decoder decoder(*this);
+            return decoder.decode(jsonString);
+        }
+
+        bool mobilitypath::asJsonObject(json_writer *writer) const
         {
             try
             {
@@ -183,11 +381,9 @@ namespace message_services
             return out;
         }
 
-        std::string mobilitypath::generate_hash_sender_timestamp_id(std::string sender_bsm_id, uint64_t timestamp)
+        correlation_key_t mobilitypath::get_sender_timestamp_key(uint64_t timestamp_bucket_duration) const
         {
-            std::stringstream hash_ss;
-            hash_ss << sender_bsm_id << timestamp;
-            return hash_ss.str();
+            return make_sender_timestamp_key(this->packed_sender_id, this->header.timestamp / timestamp_bucket_duration);
         }
         mobility_header_t mobilitypath::getHeader() const
         {
@@ -196,6 +392,7 @@ namespace message_services
         void mobilitypath::setHeader(mobility_header_t header)
         {
             this->header = header;
+            this->packed_sender_id = pack_correlation_id(this->header.sender_id);
         }
 
         trajectory_t mobilitypath::getTrajectory() const
@@ -7,6 +7,7 @@
 #include "baseMessage.h"
 #include "mobilityHeader.h"
 #include "trajectory.h"
+#include "correlation_key.h"
 
 namespace message_services
 {
@@ -20,6 +21,8 @@ namespace message_services
 
         private:
             mobility_header_t header;
+            // Sender id packed when the header is set
+            uint64_t packed_sender_id = 0;
             trajectory_t trajectory;
 
         public:
@@ -29,9 +32,18 @@ namespace message_services
             //Current timestamp in unit of milliseconds
             std::time_t msg_received_timestamp_ = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
+            /**
+             * @brief Decode a MobilityPath with the rapidjson SAX reader without building a DOM.
+             * @return false if jsonString is not valid JSON or a header or trajectory member holds an invalid value
+             * **/
+            virtual bool fromJson(std::string_view jsonString);
             virtual void fromJsonObject(const rapidjson::Value &obj);
-            virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const;
-            std::string generate_hash_sender_timestamp_id( std::string sender_bsm_id, uint64_t timestamp );
+            virtual bool asJsonObject(json_writer *writer) const;
+            /**
+             * @brief Key of this MobilityPath referenced by MobilityOperation messages of the same sender.
+             * @param timestamp_bucket_duration duration in milliseconds of the timestamp buckets MobilityOperation and MobilityPath are matched in
+             * **/
+            correlation_key_t get_sender_timestamp_key(uint64_t timestamp_bucket_duration) const;
 
             trajectory_t getTrajectory() const;
             void setTrajectory(trajectory_t trajectory);
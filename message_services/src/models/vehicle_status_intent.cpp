@@ -81,7 +81,7 @@ namespace message_services
                 }
             }
         }
-        bool vehicle_status_intent::asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const
+        bool vehicle_status_intent::asJsonObject(json_writer *writer) const
         {
             try
             {
@@ -58,7 +58,7 @@ namespace message_services
             virtual ~vehicle_status_intent();
 
             virtual void fromJsonObject(const rapidjson::Value &obj);
-            virtual bool asJsonObject(rapidjson::Writer<rapidjson::StringBuffer> *writer) const;
+            virtual bool asJsonObject(json_writer *writer) const;
 
             //getters and setters
             std::string getVehicle_id() const;
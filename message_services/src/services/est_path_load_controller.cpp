@@ -0,0 +1,93 @@
+#include "est_path_load_controller.h"
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace message_services
+{
+    namespace services
+    {
+        est_path_load_controller::est_path_load_controller(const est_path_settings_t &configured, std::int64_t load_budget_ms)
+            : _configured(configured), _settings(configured), _load_budget_ms(load_budget_ms)
+        {
+        }
+
+        void est_path_load_controller::set_level(int level, std::time_t cur_timestamp)
+        {
+            _level = level;
+            _last_step_timestamp = cur_timestamp;
+            _low_load_since = 0;
+            _settings = _configured;
+            if (_level >= 1)
+            {
+                _settings.est_path_point_count = _configured.est_path_point_count > 0 ? std::max<std::int64_t>(1, _configured.est_path_point_count / 2) : REDUCED_POINT_COUNT;
+            }
+            if (_level >= 2)
+            {
+                _settings.is_est_path_p2p_distance_only = true;
+            }
+            if (_level >= 3)
+            {
+                _settings.disable_est_path = true;
+            }
+            SPDLOG_INFO("Est path load level {0}: disable_est_path = {1}, is_est_path_p2p_distance_only = {2}, est path point count = {3}",
+                        _level, _settings.disable_est_path, _settings.is_est_path_p2p_distance_only, _settings.est_path_point_count);
+        }
+
+        void est_path_load_controller::on_batch(std::size_t backlog, std::size_t batch_size, double batch_compose_ms, std::time_t cur_timestamp)
+        {
+            // Nothing to step down if the est path is disabled by configuration
+            if (_load_budget_ms <= 0 || _configured.disable_est_path || batch_size == 0)
+            {
+                return;
+            }
+            double compose_ms = batch_compose_ms / batch_size;
+            _avg_compose_ms = _has_avg_compose_ms ? COMPOSE_TIME_WEIGHT * compose_ms + (1 - COMPOSE_TIME_WEIGHT) * _avg_compose_ms : compose_ms;
+            _has_avg_compose_ms = true;
+
+            double load_ms = estimate_load_ms(backlog);
+            if (load_ms > _load_budget_ms)
+            {
+                if (_level < MAX_LEVEL && cur_timestamp - _last_step_timestamp >= STEP_DOWN_INTERVAL_MS)
+                {
+                    SPDLOG_WARN("Compose backlog of {0} takes {1} ms, above the budget of {2} ms", backlog, load_ms, _load_budget_ms);
+                    set_level(_level + 1, cur_timestamp);
+                    // The average compose time of the new level is not known yet
+                    _has_avg_compose_ms = false;
+                }
+                _low_load_since = 0;
+            }
+            else if (load_ms * 4 <= _load_budget_ms && _level > 0)
+            {
+                if (_low_load_since == 0)
+                {
+                    _low_load_since = cur_timestamp;
+                }
+                else if (cur_timestamp - _low_load_since >= STEP_UP_HOLD_MS)
+                {
+                    set_level(_level - 1, cur_timestamp);
+                    _has_avg_compose_ms = false;
+                }
+            }
+            else
+            {
+                _low_load_since = 0;
+            }
+        }
+
+        const est_path_settings_t &est_path_load_controller::get_settings() const
+        {
+            return _settings;
+        }
+
+        int est_path_load_controller::get_level() const
+        {
+            return _level;
+        }
+
+        double est_path_load_controller::estimate_load_ms(std::size_t backlog) const
+        {
+            return backlog * _avg_compose_ms;
+        }
+    }
+}
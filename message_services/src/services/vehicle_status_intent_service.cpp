@@ -1,5 +1,7 @@
 #include "vehicle_status_intent_service.h"
 
+#include <numeric>
+
 
 
 namespace message_services
@@ -7,7 +9,6 @@ namespace message_services
 
     namespace services
     {
-        std::mutex worker_mtx;
         vehicle_status_intent_service::vehicle_status_intent_service() {}
 
 
@@ -18,11 +19,18 @@ namespace message_services
             {   
                 this->vsi_est_path_point_count = streets_service::streets_configuration::get_int_config("vsi_est_path_count");
                 this->MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION = streets_service::streets_configuration::get_int_config("mobility_path_trajectory_offset_duration");
-                this->VSI_TH_SLEEP_MILLI_SEC = streets_service::streets_configuration::get_int_config("vsi_th_sleep_milli_sec");
                 this->BSM_MSG_EXPIRE_IN_SEC = streets_service::streets_configuration::get_int_config("bsm_msg_expire_in_sec");
                 this->CLEAN_QUEUE_IN_SECS = streets_service::streets_configuration::get_int_config("clean_queue_in_secs");
+                this->CONSUMER_BATCH_SIZE = streets_service::streets_configuration::get_int_config("consumer_batch_size");
                 this->disable_est_path = streets_service::streets_configuration::get_boolean_config("disable_est_path");
                 this->is_est_path_p2p_distance_only = streets_service::streets_configuration::get_boolean_config("is_est_path_p2p_distance_only");
+                this->linearized_projection_radius = streets_service::streets_configuration::get_double_config("linearized_projection_radius");
+                this->est_path_load_budget_ms = streets_service::streets_configuration::get_int_config("est_path_load_budget_ms");
+                est_path_settings_t configured_est_path;
+                configured_est_path.disable_est_path = this->disable_est_path;
+                configured_est_path.is_est_path_p2p_distance_only = this->is_est_path_p2p_distance_only;
+                configured_est_path.est_path_point_count = this->vsi_est_path_point_count;
+                _est_path_controller = est_path_load_controller(configured_est_path, this->est_path_load_budget_ms);
 
                 // Initialize message_lanelet2_translation
                 std::string osm_file_path = streets_service::streets_configuration::get_string_config("osm_file_path");
@@ -34,34 +42,34 @@ namespace message_services
 
                 // consumer topics
                 this->bsm_topic_name = streets_service::streets_configuration::get_string_config("bsm_consumer_topic");
-                this->bsm_group_id = streets_service::streets_configuration::get_string_config("bsm_group_id");
-
                 this->mp_topic_name = streets_service::streets_configuration::get_string_config("mp_consumer_topic");
-                this->mp_group_id = streets_service::streets_configuration::get_string_config("mp_group_id");
-
                 this->mo_topic_name = streets_service::streets_configuration::get_string_config("mo_consumer_topic");
-                this->mo_group_id = streets_service::streets_configuration::get_string_config("mo_group_id");
+                this->consumer_group_id = streets_service::streets_configuration::get_string_config("consumer_group_id");
+                this->instance_id = streets_service::streets_configuration::get_string_config("instance_id");
 
                 // producer topics
                 this->vsi_topic_name = streets_service::streets_configuration::get_string_config("vsi_producer_topic");
 
-                _bsm_consumer_worker = client->create_consumer(this->bootstrap_server, this->bsm_topic_name, this->bsm_group_id);
-                _mp_consumer_worker = client->create_consumer(this->bootstrap_server, this->mp_topic_name, this->mp_group_id);
-                _mo_consumer_worker = client->create_consumer(this->bootstrap_server, this->mo_topic_name, this->mo_group_id);
+                std::vector<std::string> consumer_topics = {this->bsm_topic_name, this->mp_topic_name, this->mo_topic_name};
+                _consumer_worker = client->create_consumer(this->bootstrap_server, consumer_topics, this->consumer_group_id);
+                if (!this->instance_id.empty())
+                {
+                    // Static membership. With co-partitioned BSM, MP and MO topics the range assignor assigns each instance
+                    // the same partitions of all three topics
+                    _consumer_worker->set_group_instance_id(this->instance_id);
+                }
 
-                if (!_bsm_consumer_worker->init() || !_mp_consumer_worker->init() || !_mo_consumer_worker->init())
+                if (!_consumer_worker->init())
                 {
-                    SPDLOG_CRITICAL("kafka consumers (_bsm_consumer_worker, _mp_consumer_worker or _mo_consumer_worker) initialize error");
+                    SPDLOG_CRITICAL("kafka consumer (_consumer_worker) initialize error");
                     return false;
                 }
                 else
                 {
-                    _bsm_consumer_worker->subscribe();
-                    _mp_consumer_worker->subscribe();
-                    _mo_consumer_worker->subscribe();
-                    if (!_bsm_consumer_worker->is_running() || !_mp_consumer_worker->is_running() || !_mo_consumer_worker->is_running())
+                    _consumer_worker->subscribe();
+                    if (!_consumer_worker->is_running())
                     {
-                        SPDLOG_CRITICAL("consumer_workers (_bsm_consumer_worker, _mp_consumer_worker or _mo_consumer_worker) is not running");
+                        SPDLOG_CRITICAL("consumer_worker (_consumer_worker) is not running");
                         return false;
                     }
                 }
@@ -75,6 +83,7 @@ namespace message_services
 
                 try {
                     _msg_lanelet2_translate_ptr = std::make_shared<message_translations::message_lanelet2_translation>(osm_file_path);
+                    _msg_lanelet2_translate_ptr->init_linearized_projection(this->linearized_projection_radius);
                 }
                 catch( const exceptions::message_lanelet2_translation_exception &e ) {
                     SPDLOG_ERROR("Exception encounted during initialization! \n {0}", e.what());
@@ -92,19 +101,9 @@ namespace message_services
 
         vehicle_status_intent_service::~vehicle_status_intent_service()
         {
-            if (_bsm_consumer_worker)
-            {
-                _bsm_consumer_worker->stop();
-            }
-
-            if (_mo_consumer_worker)
-            {
-                _mo_consumer_worker->stop();
-            }
-
-            if (_mp_consumer_worker)
+            if (_consumer_worker)
             {
-                _mp_consumer_worker->stop();
+                _consumer_worker->stop();
             }
         }
 
@@ -120,129 +119,47 @@ namespace message_services
                                                 std::shared_ptr<message_services::workers::mobilitypath_worker> mp_w_ptr,
                                                 std::shared_ptr<message_services::workers::mobilityoperation_worker> mo_w_ptr)
         {
-            std::thread mp_t(&vehicle_status_intent_service::msg_consumer<workers::mobilitypath_worker>, this, std::ref(mp_w_ptr), this->_mp_consumer_worker);
-            std::thread bsm_t(&vehicle_status_intent_service::msg_consumer<workers::bsm_worker>, this, std::ref(bsm_w_ptr), this->_bsm_consumer_worker);
-            std::thread mo_t(&vehicle_status_intent_service::msg_consumer<workers::mobilityoperation_worker>, this, std::ref(mo_w_ptr), this->_mo_consumer_worker);
-
-            std::shared_ptr<models::vehicle_status_intent> vsi_ptr = std::make_shared<models::vehicle_status_intent>();
+            std::thread consumer_t(&vehicle_status_intent_service::msg_consumer, this, bsm_w_ptr, mp_w_ptr, mo_w_ptr);
+            std::thread compose_t(&vehicle_status_intent_service::vsi_composer, this);
+            consumer_t.join();
+            compose_t.join();
+        }
 
-            std::thread vsi_t{
-                [bsm_w_ptr, mo_w_ptr, mp_w_ptr, this, vsi_ptr]()
+        void vehicle_status_intent_service::vsi_composer()
+        {
+            std::deque<vsi_message_bucket_t> buckets;
+            while (_consumer_worker->is_running())
+            {
                 {
-                    while (true)
-                    {
-                        if (mo_w_ptr && mo_w_ptr->get_curr_list().size() > 0 && bsm_w_ptr && bsm_w_ptr->get_curr_map().size() > 0 && mp_w_ptr && mp_w_ptr->get_curr_map().size() > 0)
-                        {
-                            SPDLOG_TRACE("Processing the BSM, mobilityOperation and MP from list...");
-                            std::unique_lock<std::mutex> lck(worker_mtx);
-                            while (mo_w_ptr && !mo_w_ptr->get_curr_list().empty())
-                            {
-                                SPDLOG_TRACE("MO list SIZE = {0}", mo_w_ptr->get_curr_list().size());
-                                SPDLOG_TRACE("MP map SIZE = {0}", mp_w_ptr->get_curr_map().size());
-                                SPDLOG_TRACE("BSM map SIZE = {0}", bsm_w_ptr->get_curr_map().size());
-                                message_services::models::mobilityoperation subj_mo = mo_w_ptr->get_curr_list().front();
-                                mo_w_ptr->get_curr_list().pop_front();
-
-                                message_services::models::mobilitypath subj_mp;
-                                message_services::models::bsm subj_bsm;
-                                bool is_bsm_msg_count_id_found = false;
-                                std::time_t cur_local_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                                std::string bsm_msg_id = subj_mo.generate_hash_bsm_msg_id(subj_mo.getHeader().sender_bsm_id, std::stol(subj_mo.get_value_from_strategy_params("msg_count")), std::stol(subj_mo.get_value_from_strategy_params("sec_mark")));
-                                if (bsm_w_ptr->get_curr_map().find(bsm_msg_id) != bsm_w_ptr->get_curr_map().end())
-                                {
-                                    subj_bsm = bsm_w_ptr->get_curr_map()[bsm_msg_id];
-
-                                    if (std::abs(cur_local_timestamp - subj_bsm.msg_received_timestamp_) > (this->BSM_MSG_EXPIRE_IN_SEC * 1000))
-                                    {
-                                        SPDLOG_WARN("BSM EXPIRED {0}", std::abs(cur_local_timestamp - subj_bsm.msg_received_timestamp_));
-                                        bsm_w_ptr->get_curr_map().erase(bsm_msg_id);
-                                        continue;
-                                    }
-                                    is_bsm_msg_count_id_found = true;
-                                }
-                                else
-                                {
-                                    continue;
-                                }
-
-                                std::string sender_timestamp_msg_id = subj_mo.generate_hash_sender_timestamp_id(subj_mo.getHeader().sender_id, subj_mo.getHeader().timestamp / this->MOBILITY_OPERATION_PATH_MAX_DURATION);
-
-                                if (is_bsm_msg_count_id_found && mp_w_ptr->get_curr_map().find(sender_timestamp_msg_id) != mp_w_ptr->get_curr_map().end())
-                                {
-                                    subj_mp = mp_w_ptr->get_curr_map()[sender_timestamp_msg_id];
-                                }
-                                else
-                                {
-                                    continue;
-                                }
-
-                                *vsi_ptr = compose_vehicle_status_intent(subj_bsm, subj_mo, subj_mp);
-                                if (vsi_ptr)
-                                {
-                                    SPDLOG_DEBUG("Correlated vehicle status intent for {0}", vsi_ptr->getVehicle_id());
-                                    std::string msg_to_pub = vsi_ptr->asJson();
-                                    this->publish_msg<const char *>(msg_to_pub.c_str(), this->_vsi_producer_worker);
-                                }
-                                mp_w_ptr->get_curr_map().erase(sender_timestamp_msg_id);
-                                bsm_w_ptr->get_curr_map().erase(bsm_msg_id);
-                            }
-                        }
-
-                        std::time_t cur_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                        if (std::abs(cur_timestamp - this->prev_msg_expired_timestamp_) > (this->CLEAN_QUEUE_IN_SECS * 1000))
-                        {
-                            SPDLOG_DEBUG("Clean the BSM and MP...");
-                            SPDLOG_DEBUG("MO list SIZE = {0}", mo_w_ptr->get_curr_list().size());
-                            SPDLOG_DEBUG("MP map SIZE = {0}", mp_w_ptr->get_curr_map().size());
-                            SPDLOG_DEBUG("BSM map SIZE = {0}", bsm_w_ptr->get_curr_map().size());
-
-                            if (mp_w_ptr && !mp_w_ptr->get_curr_map().empty())
-                            {
-                                SPDLOG_DEBUG("Clean the MP...");
-                                for (auto itr = mp_w_ptr->get_curr_map().cbegin(); itr != mp_w_ptr->get_curr_map().cend();)
-                                {
-                                    if (mp_w_ptr && std::abs(cur_timestamp - itr->second.msg_received_timestamp_) > (this->CLEAN_QUEUE_IN_SECS * 1000))
-                                    {
-                                        std::unique_lock<std::mutex> lck(worker_mtx);
-                                        mp_w_ptr->get_curr_map().erase(itr++);
-                                    }
-                                    else
-                                    {
-                                        ++itr;
-                                    }
-                                }
-                                SPDLOG_DEBUG("Cleaned the MP.");
-                            }
-
-                            if (bsm_w_ptr && !bsm_w_ptr->get_curr_map().empty())
-                            {
-                                SPDLOG_DEBUG("Clean the BSM...");
-                                for (auto itr = bsm_w_ptr->get_curr_map().cbegin(); itr != bsm_w_ptr->get_curr_map().cend();)
-                                {
-                                    if (bsm_w_ptr && std::abs(cur_timestamp - itr->second.msg_received_timestamp_) > (this->CLEAN_QUEUE_IN_SECS * 1000))
-                                    {
-                                        std::unique_lock<std::mutex> lck(worker_mtx);
-                                        bsm_w_ptr->get_curr_map().erase(itr++);
-                                    }
-                                    else
-                                    {
-                                        ++itr;
-                                    }
-                                }
-                                SPDLOG_DEBUG("Cleaned the BSM.");
-                            }
-
-                            prev_msg_expired_timestamp_ = cur_timestamp;
-                        }
-                        std::this_thread::sleep_for(std::chrono::milliseconds(this->VSI_TH_SLEEP_MILLI_SEC));
-                    }
-                }};
-
-            vsi_t.join();
-            mp_t.join();
-            mo_t.join();
-            bsm_t.join();
-        }     
+                    std::unique_lock<std::mutex> lck(_compose_mtx);
+                    // Wake up periodically to stop with the consumer
+                    _compose_cv.wait_for(lck, std::chrono::milliseconds(1000), [this]()
+                                         { return !_compose_queue.empty(); });
+                    buckets.swap(_compose_queue);
+                }
+                if (buckets.empty())
+                {
+                    continue;
+                }
+                auto compose_start = std::chrono::steady_clock::now();
+                for (auto &bucket : buckets)
+                {
+                    models::vehicle_status_intent vsi = compose_vehicle_status_intent(bucket.bsm, bucket.mo, bucket.mp);
+                    SPDLOG_DEBUG("Correlated vehicle status intent for {0}", vsi.getVehicle_id());
+                    this->publish_msg(vsi.asJson(), vsi.getVehicle_id(), this->_vsi_producer_worker);
+                }
+                double compose_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compose_start).count();
+                // Correlated messages queued while composing are the backlog, its size and the compose time per vehicle status and intent set the est path level
+                std::size_t backlog = 0;
+                {
+                    std::unique_lock<std::mutex> lck(_compose_mtx);
+                    backlog = _compose_queue.size();
+                }
+                std::time_t cur_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                _est_path_controller.on_batch(backlog, buckets.size(), compose_ms, cur_timestamp);
+                buckets.clear();
+            }
+        }
 
         models::vehicle_status_intent vehicle_status_intent_service::compose_vehicle_status_intent(models::bsm &bsm,
                                                                                                    models::mobilityoperation &mo,
@@ -252,14 +169,66 @@ namespace message_services
             try
             {
                 vsi.setVehicle_id(mo.getHeader().sender_id);
-                vsi.setDepart_position(std::stol(mo.get_value_from_strategy_params("depart_pos")));
                 vsi.setCur_timestamp(mo.getHeader().timestamp);
-                vsi.setIs_allowed(std::stol(mo.get_value_from_strategy_params("access")));
-                vsi.setMax_accel(std::stod(mo.get_value_from_strategy_params("max_accel")));
-                vsi.setMax_decel(std::stod(mo.get_value_from_strategy_params("max_decel")));
-                vsi.setReact_timestamp(std::stod(mo.get_value_from_strategy_params("react_time")));
-                vsi.setMinimum_gap(std::stod(mo.get_value_from_strategy_params("min_gap")));
-                vsi.setDepart_position(std::stol(mo.get_value_from_strategy_params("depart_pos")));
+                // Strategy params are parsed once by the MobilityOperation, missing or invalid params keep their default
+                long depart_pos = 0;
+                long access = 0;
+                double max_accel = 0;
+                double max_decel = 0;
+                double react_time = 0;
+                double min_gap = 0;
+                auto warn_invalid_param = [&mo](const char *key)
+                {
+                    SPDLOG_WARN("MobilityOperation from {0} without valid strategy param {1}", mo.getHeader().sender_id, key);
+                };
+                if (mo.get_strategy_param("depart_pos", depart_pos))
+                {
+                    vsi.setDepart_position(depart_pos);
+                }
+                else
+                {
+                    warn_invalid_param("depart_pos");
+                }
+                if (mo.get_strategy_param("access", access))
+                {
+                    vsi.setIs_allowed(access);
+                }
+                else
+                {
+                    warn_invalid_param("access");
+                }
+                if (mo.get_strategy_param("max_accel", max_accel))
+                {
+                    vsi.setMax_accel(max_accel);
+                }
+                else
+                {
+                    warn_invalid_param("max_accel");
+                }
+                if (mo.get_strategy_param("max_decel", max_decel))
+                {
+                    vsi.setMax_decel(max_decel);
+                }
+                else
+                {
+                    warn_invalid_param("max_decel");
+                }
+                if (mo.get_strategy_param("react_time", react_time))
+                {
+                    vsi.setReact_timestamp(react_time);
+                }
+                else
+                {
+                    warn_invalid_param("react_time");
+                }
+                if (mo.get_strategy_param("min_gap", min_gap))
+                {
+                    vsi.setMinimum_gap(min_gap);
+                }
+                else
+                {
+                    warn_invalid_param("min_gap");
+                }
 
                 // Update vehicle status intent with BSM
                 vsi.setVehicle_length(bsm.getCore_data().size.length);
@@ -281,99 +250,92 @@ namespace message_services
                 vsi.setCur_lanelet_id(cur_lanelet.id());
                 vsi.setCur_distance(_msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(cur_basic_point3d, cur_lanelet, turn_direction, trajectory));      
             
-            if(!disable_est_path)
-            {
-                // Update vehicle status intent with MobilityPath
-                models::est_path_t est_path;
-                std::vector<models::est_path_t> est_path_v;
-                int32_t ecef_x = mp.getTrajectory().location.ecef_x;
-                int32_t ecef_y = mp.getTrajectory().location.ecef_y;
-                int32_t ecef_z = mp.getTrajectory().location.ecef_z;
-                long timestamp = mp.getHeader().timestamp;
-
-                SPDLOG_DEBUG("MobilityPath location ecef_x: {0}", ecef_x);
-                SPDLOG_DEBUG("MobilityPath location ecef_y: {0}", ecef_y);
-                SPDLOG_DEBUG("MobilityPath location ecef_z: {0}", ecef_z);
-                lanelet::BasicPoint3d mp_start_point = _msg_lanelet2_translate_ptr->ecef_2_map_point(ecef_x, ecef_y, ecef_z);
-                if(is_est_path_p2p_distance_only)
+                // Est path settings of the current load level
+                const est_path_settings_t &est_path_settings = _est_path_controller.get_settings();
+                if(!est_path_settings.disable_est_path)
                 {
-                    est_path.distance = lanelet::geometry::distance(lanelet::utils::to2D(cur_basic_point3d),lanelet::utils::to2D(mp_start_point));
-                    est_path.lanelet_id = cur_lanelet.id(); //Set the lanelet id to the current vehicle lanelet id
-                }
-                else
-                {
-                    lanelet::Lanelet mp_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(mp_start_point, turn_direction, trajectory);
-                    est_path.distance = _msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(mp_start_point,mp_point_lanelet, turn_direction, trajectory);
-                    est_path.lanelet_id = mp_point_lanelet.id();
-                }
-                est_path.timestamp = timestamp;
-                est_path_v.push_back(est_path);
-
-                int32_t count = 1;
-                size_t next_index = 0;
-                double accumulated_distance_to_previous_point = 0;
-                lanelet::BasicPoint3d mp_cur_point = mp_start_point;
-                for (size_t offset_index = 0; offset_index < trajectory.offsets.size(); offset_index++)
-                {
-                    ecef_x += trajectory.offsets.at(offset_index).offset_x;
-                    ecef_y += trajectory.offsets.at(offset_index).offset_y;
-                    ecef_z += trajectory.offsets.at(offset_index).offset_z;
-
-                    SPDLOG_DEBUG("MobilityPath location offset_x: {0}", trajectory.offsets.at(offset_index).offset_x);
-                    SPDLOG_DEBUG("MobilityPath location offset_y: {0}", trajectory.offsets.at(offset_index).offset_y);
-                    SPDLOG_DEBUG("MobilityPath location offset_z: {0}", trajectory.offsets.at(offset_index).offset_z);
-                    est_path.timestamp += 100; // The duration between two points is 0.1 sec
-                    
-                    //Calculate the distance between two points (interval 0.1 secs) from the MobilityPath message starting from the current vehicle location                
-                    if(is_est_path_p2p_distance_only)
-                    {   
-                        lanelet::BasicPoint3d mp_previous_point = mp_cur_point;
-                        mp_cur_point = _msg_lanelet2_translate_ptr->ecef_2_map_point(ecef_x, ecef_y, ecef_z);
-                        accumulated_distance_to_previous_point += lanelet::geometry::distance2d(lanelet::utils::to2D(mp_cur_point),lanelet::utils::to2D(mp_previous_point));                        
+                    // Update vehicle status intent with MobilityPath
+                    models::est_path_t est_path;
+                    std::vector<models::est_path_t> est_path_v;
+                    long timestamp = mp.getHeader().timestamp;
+
+                    SPDLOG_DEBUG("MobilityPath location ecef_x: {0}", trajectory.location.ecef_x);
+                    SPDLOG_DEBUG("MobilityPath location ecef_y: {0}", trajectory.location.ecef_y);
+                    SPDLOG_DEBUG("MobilityPath location ecef_z: {0}", trajectory.location.ecef_z);
+
+                    // Est path points after the start point are every MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION offsets, up to the configured number of points
+                    std::vector<std::size_t> est_path_offsets;
+                    for (std::size_t offset_index = this->MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION;
+                         this->MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION > 0 && offset_index < trajectory.offsets.size();
+                         offset_index += this->MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION)
+                    {
+                        if (est_path_settings.est_path_point_count != 0 && est_path_offsets.size() >= static_cast<std::size_t>(est_path_settings.est_path_point_count))
+                        {
+                            break;
+                        }
+                        est_path_offsets.push_back(offset_index);
                     }
 
-                    if (next_index != offset_index)
+                    // Point to point distances follow every offset up to the last est path point, distances to the lanelet end
+                    // only need the est path points
+                    std::vector<std::size_t> projected_offsets;
+                    if (est_path_settings.is_est_path_p2p_distance_only)
                     {
-                        continue;
+                        projected_offsets.resize(est_path_offsets.empty() ? 0 : est_path_offsets.back() + 1);
+                        std::iota(projected_offsets.begin(), projected_offsets.end(), 0);
                     }
-                    next_index += this->MOBILITY_PATH_TRAJECTORY_OFFSET_DURATION;
-
-                    // Skip the first point
-                    if (offset_index == 0)
+                    else
                     {
-                        continue;
+                        projected_offsets = est_path_offsets;
                     }
+                    std::vector<lanelet::BasicPoint3d> mp_points = _msg_lanelet2_translate_ptr->trajectory_2_map_points(trajectory, projected_offsets);
 
-                    //If the est_path only includes the distance to previous point, the distance is set to accumulated distance to previous point.
-                    if(is_est_path_p2p_distance_only)
+                    const lanelet::BasicPoint3d &mp_start_point = mp_points.front();
+                    if(est_path_settings.is_est_path_p2p_distance_only)
                     {
-                        est_path.distance = accumulated_distance_to_previous_point;
+                        est_path.distance = lanelet::geometry::distance(lanelet::utils::to2D(cur_basic_point3d),lanelet::utils::to2D(mp_start_point));
                         est_path.lanelet_id = cur_lanelet.id(); //Set the lanelet id to the current vehicle lanelet id
-
-                        //reset the accumulated distance, and start to calculate from the latest point
-                        accumulated_distance_to_previous_point = 0;
                     }
                     else
                     {
-                        lanelet::BasicPoint3d trajectory_point = _msg_lanelet2_translate_ptr->ecef_2_map_point(ecef_x, ecef_y, ecef_z);
-                        lanelet::Lanelet trajectory_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(trajectory_point, turn_direction, trajectory);            
-                        est_path.distance = _msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(trajectory_point, trajectory_point_lanelet, turn_direction, trajectory);
-                        est_path.lanelet_id = trajectory_point_lanelet.id();
+                        lanelet::Lanelet mp_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(mp_start_point, turn_direction, trajectory);
+                        est_path.distance = _msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(mp_start_point,mp_point_lanelet, turn_direction, trajectory);
+                        est_path.lanelet_id = mp_point_lanelet.id();
                     }
-                    
+                    est_path.timestamp = timestamp;
                     est_path_v.push_back(est_path);
-                    count++;
 
-                    // Allow to configure the number of mobilityPath offsets sent as part of VSI (vehicle status and intent)
-                    if (this->vsi_est_path_point_count != 0 && count > this->vsi_est_path_point_count)
+                    // Index in mp_points of the previous est path point
+                    std::size_t previous_point = 0;
+                    for (std::size_t i = 0; i < est_path_offsets.size(); i++)
                     {
-                        break;
+                        est_path.timestamp = timestamp + 100 * (est_path_offsets[i] + 1); // The duration between two points is 0.1 sec
+
+                        //If the est_path only includes the distance to previous point, the distance is the sum of the distances between the offsets since the previous point.
+                        if(est_path_settings.is_est_path_p2p_distance_only)
+                        {
+                            std::size_t point = est_path_offsets[i] + 1;
+                            double accumulated_distance_to_previous_point = 0;
+                            for (; previous_point < point; previous_point++)
+                            {
+                                accumulated_distance_to_previous_point += lanelet::geometry::distance2d(lanelet::utils::to2D(mp_points[previous_point + 1]),lanelet::utils::to2D(mp_points[previous_point]));
+                            }
+                            est_path.distance = accumulated_distance_to_previous_point;
+                            est_path.lanelet_id = cur_lanelet.id(); //Set the lanelet id to the current vehicle lanelet id
+                        }
+                        else
+                        {
+                            const lanelet::BasicPoint3d &trajectory_point = mp_points[i + 1];
+                            lanelet::Lanelet trajectory_point_lanelet = _msg_lanelet2_translate_ptr->get_cur_lanelet_by_point_and_direction(trajectory_point, turn_direction, trajectory);
+                            est_path.distance = _msg_lanelet2_translate_ptr->distance2_cur_lanelet_end(trajectory_point, trajectory_point_lanelet, turn_direction, trajectory);
+                            est_path.lanelet_id = trajectory_point_lanelet.id();
+                        }
+                        est_path_v.push_back(est_path);
                     }
+
+                    vsi.setEst_path_v(est_path_v);
                 }
 
-                vsi.setEst_path_v(est_path_v);
-            }
-            
                 std::map<int64_t, models::intersection_lanelet_type> lanelet_id_type_m = _msg_lanelet2_translate_ptr->get_lanelet_types_ids(cur_lanelet, turn_direction);
                 for (auto itr = lanelet_id_type_m.begin(); itr != lanelet_id_type_m.end(); itr++)
                 {
@@ -402,35 +364,70 @@ namespace message_services
             }
         }
 
-        template <typename T>
-        void vehicle_status_intent_service::msg_consumer(std::shared_ptr<T> msg_w_ptr, std::shared_ptr<kafka_clients::kafka_consumer_worker> consumer_worker)
+        void vehicle_status_intent_service::msg_consumer(std::shared_ptr<message_services::workers::bsm_worker> bsm_w_ptr,
+                                                         std::shared_ptr<message_services::workers::mobilitypath_worker> mp_w_ptr,
+                                                         std::shared_ptr<message_services::workers::mobilityoperation_worker> mo_w_ptr)
         {
-            while (consumer_worker->is_running())
+            if (!bsm_w_ptr || !mp_w_ptr || !mo_w_ptr)
             {
-                const std::string payload = consumer_worker->consume(1000);
-                if (payload.length() != 0 && msg_w_ptr)
+                SPDLOG_CRITICAL("Message worker is not initialized");
+                return;
+            }
+            // Transparent comparator to look up the std::string_view topic of consumed messages without a copy
+            const std::map<std::string, correlation_msg_type, std::less<>> type_by_topic = {{this->bsm_topic_name, correlation_msg_type::BSM},
+                                                                              {this->mp_topic_name, correlation_msg_type::MOBILITY_PATH},
+                                                                              {this->mo_topic_name, correlation_msg_type::MOBILITY_OPERATION}};
+            vsi_correlation_engine engine(bsm_w_ptr, mp_w_ptr, mo_w_ptr);
+            engine.set_bsm_msg_expire_in_ms(this->BSM_MSG_EXPIRE_IN_SEC * 1000);
+            engine.set_clean_queue_in_ms(this->CLEAN_QUEUE_IN_SECS * 1000);
+            engine.set_mobility_operation_path_max_duration(this->MOBILITY_OPERATION_PATH_MAX_DURATION);
+            std::vector<vsi_message_bucket_t> completed;
+            uint64_t revoked_cnt = _consumer_worker->get_revoked_count();
+            while (_consumer_worker->is_running())
+            {
+                const std::vector<kafka_clients::kafka_message> batch = _consumer_worker->consume_batch(this->CONSUMER_BATCH_SIZE, 100);
+                if (_consumer_worker->get_revoked_count() != revoked_cnt)
                 {
-                    std::unique_lock<std::mutex> lck(worker_mtx);
-                    msg_w_ptr->process_incoming_msg(payload);
+                    // Correlation state is partition local. Messages of revoked partitions are now correlated by the
+                    // group member the partitions were assigned to.
+                    SPDLOG_INFO("Partitions revoked, clearing correlation state");
+                    revoked_cnt = _consumer_worker->get_revoked_count();
+                    engine.clear_state();
                 }
-
-                if (!msg_w_ptr)
+                for (const auto &message : batch)
                 {
-                    SPDLOG_CRITICAL("Message worker is not initialized");
+                    auto type_itr = type_by_topic.find(message.topic());
+                    if (type_itr != type_by_topic.end())
+                    {
+                        engine.on_message(type_itr->second, message.payload(), completed);
+                    }
+                    else
+                    {
+                        SPDLOG_WARN("Consumed message from unexpected topic {0}", message.topic());
+                    }
                 }
+                if (!completed.empty())
+                {
+                    {
+                        std::unique_lock<std::mutex> lck(_compose_mtx);
+                        std::move(completed.begin(), completed.end(), std::back_inserter(_compose_queue));
+                    }
+                    _compose_cv.notify_one();
+                    completed.clear();
+                }
+
+                // Expiry only visits expired messages, run it after every batch instead of sweeping every CLEAN_QUEUE_IN_SECS
+                std::time_t cur_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                engine.expire(cur_timestamp);
             }
             return;
         }
 
-        template <typename T>
-        void vehicle_status_intent_service::publish_msg(T msg,  std::shared_ptr<kafka_clients::kafka_producer_worker> producer_worker)
+        void vehicle_status_intent_service::publish_msg(std::string &&msg, const std::string &key, std::shared_ptr<kafka_clients::kafka_producer_worker> producer_worker)
         {
-            std::string msg_to_send = "";
-            msg_to_send = (char *)msg;
-
-            if (msg_to_send.length() > 0)
+            if (msg.length() > 0)
             {
-                producer_worker->send(msg_to_send);
+                producer_worker->send(std::move(msg), key);
             }
             return;
         }
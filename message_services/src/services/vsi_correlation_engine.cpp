@@ -0,0 +1,192 @@
+#include "vsi_correlation_engine.h"
+
+namespace message_services
+{
+    namespace services
+    {
+        namespace
+        {
+            std::time_t current_timestamp()
+            {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+        }
+
+        vsi_correlation_engine::vsi_correlation_engine(std::shared_ptr<workers::bsm_worker> bsm_w_ptr,
+                                                       std::shared_ptr<workers::mobilitypath_worker> mp_w_ptr,
+                                                       std::shared_ptr<workers::mobilityoperation_worker> mo_w_ptr)
+            : _bsm_w_ptr(bsm_w_ptr), _mp_w_ptr(mp_w_ptr), _mo_w_ptr(mo_w_ptr)
+        {
+        }
+
+        void vsi_correlation_engine::set_bsm_msg_expire_in_ms(std::int64_t bsm_msg_expire_in_ms)
+        {
+            this->BSM_MSG_EXPIRE_IN_MS = bsm_msg_expire_in_ms;
+        }
+
+        void vsi_correlation_engine::set_clean_queue_in_ms(std::int64_t clean_queue_in_ms)
+        {
+            this->CLEAN_QUEUE_IN_MS = clean_queue_in_ms;
+            _bsm_w_ptr->set_expiry_window(clean_queue_in_ms);
+            _mp_w_ptr->set_expiry_window(clean_queue_in_ms);
+        }
+
+        void vsi_correlation_engine::set_mobility_operation_path_max_duration(std::int32_t max_duration)
+        {
+            this->MOBILITY_OPERATION_PATH_MAX_DURATION = max_duration;
+        }
+
+        void vsi_correlation_engine::on_message(correlation_msg_type type, std::string_view json_str, std::vector<vsi_message_bucket_t> &completed)
+        {
+            switch (type)
+            {
+            case correlation_msg_type::BSM:
+                on_bsm(json_str, completed);
+                break;
+            case correlation_msg_type::MOBILITY_PATH:
+                on_mp(json_str, completed);
+                break;
+            case correlation_msg_type::MOBILITY_OPERATION:
+                on_mo(json_str, completed);
+                break;
+            }
+        }
+
+        void vsi_correlation_engine::on_bsm(std::string_view json_str, std::vector<vsi_message_bucket_t> &completed)
+        {
+            models::correlation_key_t bsm_msg_key;
+            if (_bsm_w_ptr->process_incoming_msg(json_str, bsm_msg_key))
+            {
+                complete_pending(_pending_by_bsm_key, bsm_msg_key, completed);
+            }
+        }
+
+        void vsi_correlation_engine::on_mp(std::string_view json_str, std::vector<vsi_message_bucket_t> &completed)
+        {
+            models::correlation_key_t mp_msg_key;
+            if (_mp_w_ptr->process_incoming_msg(json_str, mp_msg_key))
+            {
+                complete_pending(_pending_by_mp_key, mp_msg_key, completed);
+            }
+        }
+
+        void vsi_correlation_engine::on_mo(std::string_view json_str, std::vector<vsi_message_bucket_t> &completed)
+        {
+            pending_mo pending;
+            if (!_mo_w_ptr->parse_incoming_msg(json_str, pending.mo))
+            {
+                return;
+            }
+            if (!pending.mo.get_bsm_msg_key(pending.bsm_msg_key))
+            {
+                SPDLOG_WARN("MobilityOperation from {0} without valid msg_count and sec_mark", pending.mo.getHeader().sender_id);
+                return;
+            }
+            pending.mp_msg_key = pending.mo.get_sender_timestamp_key(this->MOBILITY_OPERATION_PATH_MAX_DURATION);
+            if (try_complete(pending, current_timestamp(), completed))
+            {
+                return;
+            }
+            auto pending_itr = _pending_mo.insert(_pending_mo.end(), std::move(pending));
+            _pending_by_bsm_key.emplace(pending_itr->bsm_msg_key, pending_itr);
+            _pending_by_mp_key.emplace(pending_itr->mp_msg_key, pending_itr);
+        }
+
+        void vsi_correlation_engine::complete_pending(std::unordered_multimap<models::correlation_key_t, std::list<pending_mo>::iterator, models::correlation_key_hash> &index,
+                                                      const models::correlation_key_t &msg_key, std::vector<vsi_message_bucket_t> &completed)
+        {
+            auto range = index.equal_range(msg_key);
+            if (range.first == range.second)
+            {
+                return;
+            }
+            // Copy iterators, erase_pending invalidates the range
+            std::vector<std::list<pending_mo>::iterator> candidates;
+            for (auto itr = range.first; itr != range.second; ++itr)
+            {
+                candidates.push_back(itr->second);
+            }
+            std::time_t cur_timestamp = current_timestamp();
+            for (auto pending_itr : candidates)
+            {
+                if (try_complete(*pending_itr, cur_timestamp, completed))
+                {
+                    erase_pending(pending_itr);
+                }
+            }
+        }
+
+        bool vsi_correlation_engine::try_complete(const pending_mo &pending, std::time_t cur_timestamp, std::vector<vsi_message_bucket_t> &completed)
+        {
+            auto &bsm_map = _bsm_w_ptr->get_curr_map();
+            auto bsm_itr = bsm_map.find(pending.bsm_msg_key);
+            if (bsm_itr == bsm_map.end())
+            {
+                return false;
+            }
+            if (std::abs(cur_timestamp - bsm_itr->second.msg_received_timestamp_) > this->BSM_MSG_EXPIRE_IN_MS)
+            {
+                SPDLOG_WARN("BSM EXPIRED {0}", std::abs(cur_timestamp - bsm_itr->second.msg_received_timestamp_));
+                bsm_map.erase(bsm_itr);
+                return false;
+            }
+            auto &mp_map = _mp_w_ptr->get_curr_map();
+            auto mp_itr = mp_map.find(pending.mp_msg_key);
+            if (mp_itr == mp_map.end())
+            {
+                return false;
+            }
+            completed.push_back({pending.mo, std::move(bsm_itr->second), std::move(mp_itr->second)});
+            bsm_map.erase(bsm_itr);
+            mp_map.erase(mp_itr);
+            return true;
+        }
+
+        void vsi_correlation_engine::erase_pending(std::list<pending_mo>::iterator pending_itr)
+        {
+            auto erase_index_entry = [pending_itr](std::unordered_multimap<models::correlation_key_t, std::list<pending_mo>::iterator, models::correlation_key_hash> &index,
+                                                   const models::correlation_key_t &msg_key)
+            {
+                auto range = index.equal_range(msg_key);
+                for (auto itr = range.first; itr != range.second; ++itr)
+                {
+                    if (itr->second == pending_itr)
+                    {
+                        index.erase(itr);
+                        return;
+                    }
+                }
+            };
+            erase_index_entry(_pending_by_bsm_key, pending_itr->bsm_msg_key);
+            erase_index_entry(_pending_by_mp_key, pending_itr->mp_msg_key);
+            _pending_mo.erase(pending_itr);
+        }
+
+        void vsi_correlation_engine::expire(std::time_t cur_timestamp)
+        {
+            // Pending MobilityOperations are in arrival order
+            while (!_pending_mo.empty() && cur_timestamp - _pending_mo.front().mo.msg_received_timestamp_ >= this->CLEAN_QUEUE_IN_MS)
+            {
+                erase_pending(_pending_mo.begin());
+            }
+
+            _mp_w_ptr->expire(cur_timestamp);
+            _bsm_w_ptr->expire(cur_timestamp);
+        }
+
+        void vsi_correlation_engine::clear_state()
+        {
+            _pending_by_bsm_key.clear();
+            _pending_by_mp_key.clear();
+            _pending_mo.clear();
+            _bsm_w_ptr->clear_state();
+            _mp_w_ptr->clear_state();
+            _mo_w_ptr->clear_state();
+        }
+
+        std::size_t vsi_correlation_engine::get_pending_count() const
+        {
+            return _pending_mo.size();
+        }
+    }
+}
@@ -18,29 +18,69 @@ namespace message_services
             return this->bsm_v;
         }
 
-        std::map<std::string, message_services::models::bsm> &bsm_worker::get_curr_map()
+        std::unordered_map<models::correlation_key_t, message_services::models::bsm, models::correlation_key_hash> &bsm_worker::get_curr_map()
         {
             return this->bsm_m;
         }
-        void bsm_worker::process_incoming_msg(const std::string json_str)
+        void bsm_worker::process_incoming_msg(std::string_view json_str)
+        {
+            models::correlation_key_t bsm_msg_key;
+            process_incoming_msg(json_str, bsm_msg_key);
+        }
+
+        bool bsm_worker::process_incoming_msg(std::string_view json_str, models::correlation_key_t &bsm_msg_key)
         {
             message_services::models::bsm bsm_obj;
-            if (bsm_obj.fromJson(json_str.c_str()))
+            if (bsm_obj.fromJson(json_str))
             {
                 std::unique_lock<std::mutex> lck(worker_mtx);
-                std::string bsm_msg_id = bsm_obj.generate_hash_bsm_msg_id(bsm_obj.getCore_data().temprary_id, bsm_obj.getCore_data().msg_count, bsm_obj.getCore_data().sec_mark);
-                if(!this->bsm_m.empty() &&  this->bsm_m.find(bsm_msg_id) != this->bsm_m.end())
-                {
-                    this->bsm_m.erase(bsm_msg_id);
-                }
-                this->bsm_m.insert({bsm_msg_id, bsm_obj});
+                bsm_msg_key = bsm_obj.get_bsm_msg_key();
+                this->_expiry_wheel.schedule(bsm_msg_key, bsm_obj.msg_received_timestamp_ + this->_expiry_window_ms);
+                this->bsm_m.insert_or_assign(bsm_msg_key, std::move(bsm_obj));
+                return true;
             }
             else
             {
                 SPDLOG_CRITICAL("bsm_worker: Document parse error");
+                return false;
+            }
+        }
+
+        void bsm_worker::clear_state()
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            this->bsm_v.clear();
+            this->bsm_m.clear();
+            this->_expiry_wheel.clear();
+        }
+
+        void bsm_worker::set_expiry_window(std::time_t expiry_window_ms)
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            this->_expiry_window_ms = expiry_window_ms;
+            this->_expiry_wheel = timing_wheel<models::correlation_key_t>(expiry_window_ms);
+            for (const auto &[bsm_msg_key, bsm_obj] : this->bsm_m)
+            {
+                this->_expiry_wheel.schedule(bsm_msg_key, bsm_obj.msg_received_timestamp_ + expiry_window_ms);
             }
         }
 
+        std::size_t bsm_worker::expire(std::time_t cur_timestamp)
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            std::size_t expired_count = 0;
+            this->_expiry_wheel.advance(cur_timestamp, [this, cur_timestamp, &expired_count](const models::correlation_key_t &bsm_msg_key)
+                                        {
+                // Entry may have been correlated or replaced by a newer message with the same id since it was scheduled
+                auto itr = this->bsm_m.find(bsm_msg_key);
+                if (itr != this->bsm_m.end() && cur_timestamp - itr->second.msg_received_timestamp_ >= this->_expiry_window_ms)
+                {
+                    this->bsm_m.erase(itr);
+                    expired_count++;
+                } });
+            return expired_count;
+        }
+
         void bsm_worker::pop_cur_element_from_list(long element_position)
         {
             if (this->bsm_v.size() > 0)
@@ -17,20 +17,32 @@ namespace message_services
             return this->mobilityoperation_v;
         }
 
-        void mobilityoperation_worker::process_incoming_msg(const std::string json_str)
+        void mobilityoperation_worker::process_incoming_msg(std::string_view json_str)
         {
             message_services::models::mobilityoperation mobilityoperation_obj;
-            if (mobilityoperation_obj.fromJson(json_str.c_str()))
+            if (parse_incoming_msg(json_str, mobilityoperation_obj))
             {
                 std::unique_lock<std::mutex> lck(worker_mtx);
                 this->mobilityoperation_v.push_back(mobilityoperation_obj);
             }
-            else
+        }
+
+        bool mobilityoperation_worker::parse_incoming_msg(std::string_view json_str, models::mobilityoperation &mobilityoperation_obj) const
+        {
+            if (mobilityoperation_obj.fromJson(json_str))
             {
-                SPDLOG_CRITICAL("mobilityoperation_worker: Document parse error");
+                return true;
             }
-
+            SPDLOG_CRITICAL("mobilityoperation_worker: Document parse error");
+            return false;
         }
+        void mobilityoperation_worker::clear_state()
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            this->mobilityoperation_v.clear();
+            this->mobilityoperation_m.clear();
+        }
+
         void mobilityoperation_worker::pop_cur_element_from_list(long element_position)
         {
             if (this->mobilityoperation_v.size() > 0)
@@ -16,29 +16,69 @@ namespace message_services
         {
             return this->mobilitypath_v;
         }
-        std::map<std::string, message_services::models::mobilitypath> &mobilitypath_worker::get_curr_map()
+        std::unordered_map<models::correlation_key_t, message_services::models::mobilitypath, models::correlation_key_hash> &mobilitypath_worker::get_curr_map()
         {
             return this->mobilitypath_m;
         }
-        void mobilitypath_worker::process_incoming_msg(const std::string json_str)
+        void mobilitypath_worker::process_incoming_msg(std::string_view json_str)
+        {
+            models::correlation_key_t mp_msg_key;
+            process_incoming_msg(json_str, mp_msg_key);
+        }
+
+        bool mobilitypath_worker::process_incoming_msg(std::string_view json_str, models::correlation_key_t &mp_msg_key)
         {
             message_services::models::mobilitypath mobilitypath_obj;
-            if (mobilitypath_obj.fromJson(json_str.c_str()))
+            if (mobilitypath_obj.fromJson(json_str))
             {
                 std::unique_lock<std::mutex> lck(worker_mtx);
-                std::string mp_msg_id = mobilitypath_obj.generate_hash_sender_timestamp_id(mobilitypath_obj.getHeader().sender_id, mobilitypath_obj.getHeader().timestamp/this->MOBILITY_OPERATION_PATH_MAX_DURATION);
-                if(!this->mobilitypath_m.empty() && this->mobilitypath_m.find(mp_msg_id) != this->mobilitypath_m.end())
-                {
-                    this->mobilitypath_m.erase(mp_msg_id);
-                }
-                this->mobilitypath_m.insert({mp_msg_id, mobilitypath_obj});
+                mp_msg_key = mobilitypath_obj.get_sender_timestamp_key(this->MOBILITY_OPERATION_PATH_MAX_DURATION);
+                this->_expiry_wheel.schedule(mp_msg_key, mobilitypath_obj.msg_received_timestamp_ + this->_expiry_window_ms);
+                this->mobilitypath_m.insert_or_assign(mp_msg_key, std::move(mobilitypath_obj));
+                return true;
             }
             else
             {
                 SPDLOG_CRITICAL("mobilitypath_worker: Document parse error");
+                return false;
+            }
+        }
+
+        void mobilitypath_worker::clear_state()
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            this->mobilitypath_v.clear();
+            this->mobilitypath_m.clear();
+            this->_expiry_wheel.clear();
+        }
+
+        void mobilitypath_worker::set_expiry_window(std::time_t expiry_window_ms)
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            this->_expiry_window_ms = expiry_window_ms;
+            this->_expiry_wheel = timing_wheel<models::correlation_key_t>(expiry_window_ms);
+            for (const auto &[mp_msg_key, mobilitypath_obj] : this->mobilitypath_m)
+            {
+                this->_expiry_wheel.schedule(mp_msg_key, mobilitypath_obj.msg_received_timestamp_ + expiry_window_ms);
             }
         }
 
+        std::size_t mobilitypath_worker::expire(std::time_t cur_timestamp)
+        {
+            std::unique_lock<std::mutex> lck(worker_mtx);
+            std::size_t expired_count = 0;
+            this->_expiry_wheel.advance(cur_timestamp, [this, cur_timestamp, &expired_count](const models::correlation_key_t &mp_msg_key)
+                                        {
+                // Entry may have been correlated or replaced by a newer message with the same id since it was scheduled
+                auto itr = this->mobilitypath_m.find(mp_msg_key);
+                if (itr != this->mobilitypath_m.end() && cur_timestamp - itr->second.msg_received_timestamp_ >= this->_expiry_window_ms)
+                {
+                    this->mobilitypath_m.erase(itr);
+                    expired_count++;
+                } });
+            return expired_count;
+        }
+
         void mobilitypath_worker::pop_cur_element_from_list(long element_position)
         {
             if (this->mobilitypath_v.size() > 0)
@@ -31,14 +31,38 @@ TEST(test_bsm_worker, pop_cur_element_from_list)
     bsm_w_obj.process_incoming_msg(bsm_json_str_2);
     bsm_w_obj.process_incoming_msg(bsm_json_str_3);
     ASSERT_EQ(3, bsm_w_obj.get_curr_map().size());
-    bsm_w_obj.get_curr_map().erase("bsmid11216323");
+    bsm_w_obj.get_curr_map().erase(message_services::models::make_bsm_msg_key(message_services::models::pack_correlation_id("bsmid1"), 12, 16323));
     ASSERT_EQ(2, bsm_w_obj.get_curr_map().size());
-    ASSERT_EQ("bsmid2", bsm_w_obj.get_curr_map().begin()->second.getCore_data().temprary_id);
-    ASSERT_EQ(38.956287, bsm_w_obj.get_curr_map().begin()->second.getCore_data().latitude);
-    ASSERT_EQ(0, bsm_w_obj.get_curr_map().begin()->second.getCore_data().elev);
-    ASSERT_EQ(-77.150492, bsm_w_obj.get_curr_map().begin()->second.getCore_data().longitude);
-    ASSERT_EQ(14, bsm_w_obj.get_curr_map().begin()->second.getCore_data().speed);
-    ASSERT_EQ(3, bsm_w_obj.get_curr_map().begin()->second.getCore_data().size.length);
-    ASSERT_EQ(16323, bsm_w_obj.get_curr_map().begin()->second.getCore_data().sec_mark);
-    ASSERT_EQ(13, bsm_w_obj.get_curr_map().begin()->second.getCore_data().msg_count);
-}
\ No newline at end of file
+    auto bsm_itr = bsm_w_obj.get_curr_map().find(message_services::models::make_bsm_msg_key(message_services::models::pack_correlation_id("bsmid2"), 13, 16323));
+    ASSERT_NE(bsm_w_obj.get_curr_map().end(), bsm_itr);
+    ASSERT_EQ("bsmid2", bsm_itr->second.getCore_data().temprary_id);
+    ASSERT_EQ(38.956287, bsm_itr->second.getCore_data().latitude);
+    ASSERT_EQ(0, bsm_itr->second.getCore_data().elev);
+    ASSERT_EQ(-77.150492, bsm_itr->second.getCore_data().longitude);
+    ASSERT_EQ(14, bsm_itr->second.getCore_data().speed);
+    ASSERT_EQ(3, bsm_itr->second.getCore_data().size.length);
+    ASSERT_EQ(16323, bsm_itr->second.getCore_data().sec_mark);
+    ASSERT_EQ(13, bsm_itr->second.getCore_data().msg_count);
+}
+TEST(test_bsm_worker, clear_state)
+{
+    message_services::workers::bsm_worker bsm_w_obj;
+    std::string bsm_json_str = "{\"core_data\": {\"id\": \"bsmid1\",\"sec_mark\": \"1632369320\"}}";
+    bsm_w_obj.process_incoming_msg(bsm_json_str);
+    ASSERT_EQ(1, bsm_w_obj.get_curr_map().size());
+    bsm_w_obj.clear_state();
+    ASSERT_EQ(0, bsm_w_obj.get_curr_map().size());
+}
+
+TEST(test_bsm_worker, expire)
+{
+    message_services::workers::bsm_worker bsm_w_obj;
+    bsm_w_obj.set_expiry_window(1000);
+    std::string bsm_json_str = "{\"core_data\": {\"id\": \"bsmid1\",\"sec_mark\": \"1632369320\"}}";
+    bsm_w_obj.process_incoming_msg(bsm_json_str);
+    std::time_t received_timestamp = bsm_w_obj.get_curr_map().begin()->second.msg_received_timestamp_;
+    ASSERT_EQ(0, bsm_w_obj.expire(received_timestamp + 999));
+    ASSERT_EQ(1, bsm_w_obj.get_curr_map().size());
+    ASSERT_EQ(1, bsm_w_obj.expire(received_timestamp + 1000));
+    ASSERT_EQ(0, bsm_w_obj.get_curr_map().size());
+}
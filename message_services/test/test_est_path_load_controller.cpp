@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "est_path_load_controller.h"
+
+namespace
+{
+    message_services::services::est_path_settings_t configured_settings()
+    {
+        message_services::services::est_path_settings_t settings;
+        settings.disable_est_path = false;
+        settings.is_est_path_p2p_distance_only = false;
+        settings.est_path_point_count = 20;
+        return settings;
+    }
+}
+
+TEST(test_est_path_load_controller, steps_down_under_overload)
+{
+    message_services::services::est_path_load_controller controller(configured_settings(), 100);
+    ASSERT_EQ(0, controller.get_level());
+    ASSERT_EQ(20, controller.get_settings().est_path_point_count);
+
+    // 50 queued messages at 1 ms each fit the budget
+    controller.on_batch(50, 50, 50, 1000);
+    ASSERT_EQ(0, controller.get_level());
+
+    // 200 queued messages at 1 ms each exceed it
+    controller.on_batch(200, 200, 200, 1100);
+    ASSERT_EQ(1, controller.get_level());
+    ASSERT_EQ(10, controller.get_settings().est_path_point_count);
+    ASSERT_FALSE(controller.get_settings().is_est_path_p2p_distance_only);
+
+    // Step downs are rate limited
+    controller.on_batch(200, 200, 200, 1200);
+    ASSERT_EQ(1, controller.get_level());
+    controller.on_batch(200, 200, 200, 1300);
+    ASSERT_EQ(2, controller.get_level());
+    ASSERT_TRUE(controller.get_settings().is_est_path_p2p_distance_only);
+    ASSERT_FALSE(controller.get_settings().disable_est_path);
+    controller.on_batch(200, 200, 200, 1500);
+    ASSERT_EQ(3, controller.get_level());
+    ASSERT_TRUE(controller.get_settings().disable_est_path);
+    controller.on_batch(200, 200, 200, 1700);
+    ASSERT_EQ(message_services::services::est_path_load_controller::MAX_LEVEL, controller.get_level());
+}
+
+TEST(test_est_path_load_controller, steps_up_after_load_drops)
+{
+    message_services::services::est_path_load_controller controller(configured_settings(), 100);
+    controller.on_batch(200, 200, 200, 1000);
+    ASSERT_EQ(1, controller.get_level());
+
+    // Load below a quarter of the budget has to hold before stepping up
+    controller.on_batch(10, 10, 10, 1500);
+    ASSERT_EQ(1, controller.get_level());
+    controller.on_batch(10, 10, 10, 2500);
+    ASSERT_EQ(1, controller.get_level());
+    // Load between a quarter of the budget and the budget resets the hold
+    controller.on_batch(50, 50, 50, 3000);
+    controller.on_batch(10, 10, 10, 3600);
+    ASSERT_EQ(1, controller.get_level());
+    controller.on_batch(10, 10, 10, 5600);
+    ASSERT_EQ(0, controller.get_level());
+    ASSERT_EQ(20, controller.get_settings().est_path_point_count);
+}
+
+TEST(test_est_path_load_controller, disabled)
+{
+    // No budget
+    message_services::services::est_path_load_controller controller(configured_settings(), 0);
+    controller.on_batch(1000, 1000, 1000, 1000);
+    ASSERT_EQ(0, controller.get_level());
+
+    // Est path disabled by configuration
+    auto settings = configured_settings();
+    settings.disable_est_path = true;
+    message_services::services::est_path_load_controller disabled_controller(settings, 100);
+    disabled_controller.on_batch(1000, 1000, 1000, 1000);
+    ASSERT_EQ(0, disabled_controller.get_level());
+    ASSERT_TRUE(disabled_controller.get_settings().disable_est_path);
+
+    // All MobilityPath offsets configured
+    settings = configured_settings();
+    settings.est_path_point_count = 0;
+    message_services::services::est_path_load_controller all_points_controller(settings, 100);
+    all_points_controller.on_batch(1000, 1000, 1000, 1000);
+    ASSERT_EQ(message_services::services::est_path_load_controller::REDUCED_POINT_COUNT, all_points_controller.get_settings().est_path_point_count);
+}
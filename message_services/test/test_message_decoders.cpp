@@ -0,0 +1,127 @@
+#include <rapidjson/document.h>
+
+#include "gtest/gtest.h"
+#include "bsm.h"
+#include "mobilitypath.h"
+#include "mobilityoperation.h"
+
+namespace
+{
+    const std::string bsm_json_str = "{\"unknown\": {\"core_data\": {\"id\": \"ignored\"}, \"list\": [1, {\"a\": 2}]}, \"CORE_DATA\": {\"id\": \"bsmid1\", \"angle\": \"1.5\", \"lat\":\"389562870\",\"long\" :\"-771504920\",\"elev\" :\"72\",\"sec_mark\": \"16323\",\"msg_count\": \"12\", \"speed\": \"13\", \"heading\": \"90.5\", \"transmission\": \"NEUTRAL\", \"ID\": \"not_id\", "
+                                "\"size\": { \"Length\": \"500\", \"width\": \"200\"}, \"accuracy\": {\"orientation\": \"1\", \"semi_major\": \"2\", \"semi_minor\": \"3\"}, "
+                                "\"accel_set\": {\"lat\": \"0.5\", \"long\": \"-1.5\", \"vert\": \"0\", \"yaw\": \"0.25\"}, \"brakes\": {\"abs\": \"1\", \"aux_brakes\": \"2\", \"brake_boost\": \"3\", \"scs\": \"4\", \"traction\": \"5\"}}}";
+    const std::string mp_json_str = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\", \"planId\": \"plan\", \"targetStaticId\": \"\"}, "
+                                    "\"Trajectory\": { \"location\": {\"ecefX\": 1105398, \"ecefY\": -4837961,\"ecefZ\": 3984453, \"timestamp\": \"1632679657\"}, "
+                                    "\"offsets\": [{\"offsetX\": 1, \"offsetY\": -2, \"offsetZ\": 3}, {\"offsetX\": 4, \"offsetY\": 5, \"offsetZ\": -6}]}}";
+    const std::string mo_json_str = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\", \"planId\": \"plan\", \"targetStaticId\": \"\"}, \"strategy\": \"NA\",\"strategy_params\": \"msg_count: 12, sec_mark: 16323, access: 0\"}";
+
+    template <typename Model>
+    void decode_dom(const std::string &json_str, Model &model)
+    {
+        rapidjson::Document doc;
+        ASSERT_FALSE(doc.Parse(json_str.data(), json_str.size()).HasParseError());
+        model.fromJsonObject(doc);
+    }
+}
+
+TEST(test_message_decoders, bsm)
+{
+    message_services::models::bsm dom_bsm;
+    message_services::models::bsm sax_bsm;
+    decode_dom(bsm_json_str, dom_bsm);
+    ASSERT_TRUE(sax_bsm.fromJson(bsm_json_str));
+
+    auto dom_core_data = dom_bsm.getCore_data();
+    auto sax_core_data = sax_bsm.getCore_data();
+    ASSERT_EQ("bsmid1", sax_core_data.temprary_id);
+    ASSERT_EQ(dom_core_data.temprary_id, sax_core_data.temprary_id);
+    ASSERT_EQ(dom_core_data.msg_count, sax_core_data.msg_count);
+    ASSERT_EQ(dom_core_data.sec_mark, sax_core_data.sec_mark);
+    ASSERT_DOUBLE_EQ(dom_core_data.latitude, sax_core_data.latitude);
+    ASSERT_DOUBLE_EQ(dom_core_data.longitude, sax_core_data.longitude);
+    ASSERT_FLOAT_EQ(dom_core_data.elev, sax_core_data.elev);
+    ASSERT_FLOAT_EQ(dom_core_data.angle, sax_core_data.angle);
+    ASSERT_FLOAT_EQ(dom_core_data.speed, sax_core_data.speed);
+    ASSERT_FLOAT_EQ(dom_core_data.heading, sax_core_data.heading);
+    ASSERT_EQ(dom_core_data.transmission, sax_core_data.transmission);
+    ASSERT_EQ(500, sax_core_data.size.length);
+    ASSERT_EQ(dom_core_data.size.length, sax_core_data.size.length);
+    ASSERT_EQ(dom_core_data.size.width, sax_core_data.size.width);
+    ASSERT_FLOAT_EQ(dom_core_data.accuracy.orientation, sax_core_data.accuracy.orientation);
+    ASSERT_FLOAT_EQ(dom_core_data.accuracy.semiMajor, sax_core_data.accuracy.semiMajor);
+    ASSERT_FLOAT_EQ(dom_core_data.accuracy.semiMinor, sax_core_data.accuracy.semiMinor);
+    ASSERT_FLOAT_EQ(dom_core_data.accelSet.lat, sax_core_data.accelSet.lat);
+    ASSERT_FLOAT_EQ(dom_core_data.accelSet.Long, sax_core_data.accelSet.Long);
+    ASSERT_FLOAT_EQ(dom_core_data.accelSet.vert, sax_core_data.accelSet.vert);
+    ASSERT_FLOAT_EQ(dom_core_data.accelSet.yaw, sax_core_data.accelSet.yaw);
+    ASSERT_EQ(dom_core_data.brakes.abs, sax_core_data.brakes.abs);
+    ASSERT_EQ(dom_core_data.brakes.auxBrakes, sax_core_data.brakes.auxBrakes);
+    ASSERT_EQ(dom_core_data.brakes.brakeBoost, sax_core_data.brakes.brakeBoost);
+    ASSERT_EQ(dom_core_data.brakes.scs, sax_core_data.brakes.scs);
+    ASSERT_EQ(dom_core_data.brakes.traction, sax_core_data.brakes.traction);
+    ASSERT_EQ(dom_bsm.get_bsm_msg_key(), sax_bsm.get_bsm_msg_key());
+
+    // Invalid JSON and invalid numbers are rejected
+    message_services::models::bsm invalid_bsm;
+    ASSERT_FALSE(invalid_bsm.fromJson("{\"core_data\": {\"id\": \"bsmid1\""));
+    ASSERT_FALSE(invalid_bsm.fromJson("{\"core_data\": {\"id\": \"bsmid1\", \"msg_count\": \"12a\"}}"));
+    // Numbers are accepted as well as strings
+    ASSERT_TRUE(invalid_bsm.fromJson("{\"core_data\": {\"id\": \"bsmid1\", \"msg_count\": 12, \"speed\": 13.5}}"));
+    ASSERT_EQ(12, invalid_bsm.getCore_data().msg_count);
+    ASSERT_FLOAT_EQ(13.5, invalid_bsm.getCore_data().speed);
+}
+
+TEST(test_message_decoders, mobilitypath)
+{
+    message_services::models::mobilitypath dom_mp;
+    message_services::models::mobilitypath sax_mp;
+    decode_dom(mp_json_str, dom_mp);
+    ASSERT_TRUE(sax_mp.fromJson(mp_json_str));
+
+    ASSERT_EQ("DOT-507", sax_mp.getHeader().sender_id);
+    ASSERT_EQ(dom_mp.getHeader().sender_id, sax_mp.getHeader().sender_id);
+    ASSERT_EQ(dom_mp.getHeader().sender_bsm_id, sax_mp.getHeader().sender_bsm_id);
+    ASSERT_EQ(dom_mp.getHeader().plan_id, sax_mp.getHeader().plan_id);
+    ASSERT_EQ(dom_mp.getHeader().recipient_id, sax_mp.getHeader().recipient_id);
+    ASSERT_EQ(dom_mp.getHeader().timestamp, sax_mp.getHeader().timestamp);
+
+    auto dom_trajectory = dom_mp.getTrajectory();
+    auto sax_trajectory = sax_mp.getTrajectory();
+    ASSERT_EQ(-4837961, sax_trajectory.location.ecef_y);
+    ASSERT_EQ(dom_trajectory.location.ecef_x, sax_trajectory.location.ecef_x);
+    ASSERT_EQ(dom_trajectory.location.ecef_y, sax_trajectory.location.ecef_y);
+    ASSERT_EQ(dom_trajectory.location.ecef_z, sax_trajectory.location.ecef_z);
+    ASSERT_EQ(dom_trajectory.location.timestamp, sax_trajectory.location.timestamp);
+    ASSERT_EQ(2, sax_trajectory.offsets.size());
+    ASSERT_EQ(dom_trajectory.offsets.size(), sax_trajectory.offsets.size());
+    for (std::size_t i = 0; i < sax_trajectory.offsets.size(); i++)
+    {
+        ASSERT_EQ(dom_trajectory.offsets[i].offset_x, sax_trajectory.offsets[i].offset_x);
+        ASSERT_EQ(dom_trajectory.offsets[i].offset_y, sax_trajectory.offsets[i].offset_y);
+        ASSERT_EQ(dom_trajectory.offsets[i].offset_z, sax_trajectory.offsets[i].offset_z);
+    }
+    ASSERT_EQ(dom_mp.get_sender_timestamp_key(1000), sax_mp.get_sender_timestamp_key(1000));
+}
+
+TEST(test_message_decoders, mobilityoperation)
+{
+    message_services::models::mobilityoperation dom_mo;
+    message_services::models::mobilityoperation sax_mo;
+    decode_dom(mo_json_str, dom_mo);
+    ASSERT_TRUE(sax_mo.fromJson(mo_json_str));
+
+    ASSERT_EQ("bsmid1", sax_mo.getHeader().sender_bsm_id);
+    ASSERT_EQ(dom_mo.getHeader().sender_id, sax_mo.getHeader().sender_id);
+    ASSERT_EQ(dom_mo.getHeader().sender_bsm_id, sax_mo.getHeader().sender_bsm_id);
+    ASSERT_EQ(dom_mo.getHeader().plan_id, sax_mo.getHeader().plan_id);
+    ASSERT_EQ(dom_mo.getHeader().recipient_id, sax_mo.getHeader().recipient_id);
+    ASSERT_EQ(dom_mo.getHeader().timestamp, sax_mo.getHeader().timestamp);
+    ASSERT_EQ(dom_mo.getStrategy(), sax_mo.getStrategy());
+    ASSERT_EQ(dom_mo.getStrategy_params(), sax_mo.getStrategy_params());
+
+    message_services::models::correlation_key_t dom_key;
+    message_services::models::correlation_key_t sax_key;
+    ASSERT_TRUE(dom_mo.get_bsm_msg_key(dom_key));
+    ASSERT_TRUE(sax_mo.get_bsm_msg_key(sax_key));
+    ASSERT_EQ(dom_key, sax_key);
+}
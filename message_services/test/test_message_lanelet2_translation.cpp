@@ -1,7 +1,20 @@
 #include <rapidjson/document.h>
+#include <numeric>
+#include <set>
 
 #include "gtest/gtest.h"
 #include "message_lanelet2_translation.h"
+#include <lanelet2_core/geometry/LineString.h>
+
+namespace
+{
+    // Centerline length from the projection of point onto the centerline to the end of the lanelet
+    double remaining_centerline_length(const lanelet::ConstLanelet &subj_lanelet, const lanelet::BasicPoint3d &point)
+    {
+        auto centerline = subj_lanelet.centerline2d();
+        return lanelet::geometry::length(centerline) - lanelet::geometry::toArcCoordinates(centerline, lanelet::utils::to2D(point)).length;
+    }
+}
 
 TEST(test_message_lanelet2_translation, read_lanelet2_map)
 {
@@ -51,6 +64,82 @@ TEST(test_message_lanelet2_translation, get_cur_lanelet_id_by_loc_and_direction)
 
 
 
+TEST(test_message_lanelet2_translation, get_cur_lanelets_by_point)
+{
+    message_services::message_translations::message_lanelet2_translation clt("../../sample_map/town01_vector_map_test.osm");
+
+    // Position within the overlapping straight and left link lanelets is found in the intersection lanelet index
+    auto link_lanelets = clt.get_cur_lanelets_by_point(clt.gps_2_map_point(48.9977867, 8.0026431, 0));
+    std::set<lanelet::Id> link_ids;
+    for (const auto &ll : link_lanelets)
+    {
+        link_ids.insert(ll.id());
+    }
+    ASSERT_EQ(1, link_ids.count(169));
+    ASSERT_EQ(1, link_ids.count(155));
+
+    // Positions within the entry and departure lanelets
+    auto entry_lanelets = clt.get_cur_lanelets_by_point(clt.gps_2_map_point(48.9977278, 8.0026431, 0));
+    ASSERT_EQ(1, entry_lanelets.size());
+    ASSERT_EQ(167, entry_lanelets.front().id());
+    auto departure_lanelets = clt.get_cur_lanelets_by_point(clt.gps_2_map_point(48.9979572, 8.0026431, 0));
+    ASSERT_EQ(1, departure_lanelets.size());
+    ASSERT_EQ(168, departure_lanelets.front().id());
+
+    // Position outside any lanelet
+    ASSERT_TRUE(clt.get_cur_lanelets_by_point(clt.gps_2_map_point(48.9979763, 8.003000, 0)).empty());
+
+    // Without the routing graph there is no index and the whole map is searched
+    message_services::message_translations::message_lanelet2_translation clt_no_index;
+    ASSERT_TRUE(clt_no_index.read_lanelet2_map("../../sample_map/town01_vector_map_test.osm"));
+    auto map_lanelets = clt_no_index.get_cur_lanelets_by_point(clt_no_index.gps_2_map_point(48.9977278, 8.0026431, 0));
+    ASSERT_EQ(1, map_lanelets.size());
+    ASSERT_EQ(167, map_lanelets.front().id());
+}
+
+TEST(test_message_lanelet2_translation, linearized_projection)
+{
+    message_services::message_translations::message_lanelet2_translation clt("../../sample_map/town01_vector_map_test.osm");
+    message_services::models::trajectory trajectory;
+    auto start = clt.gps_2_ecef(48.9977278, 8.0026431, 0);
+    trajectory.location.ecef_x = start.x() * 100.0;
+    trajectory.location.ecef_y = start.y() * 100.0;
+    trajectory.location.ecef_z = start.z() * 100.0;
+    for (int i = 0; i < 50; i++)
+    {
+        message_services::models::locationOffsetECEF_t offset;
+        offset.offset_x = 20;
+        offset.offset_y = -35;
+        offset.offset_z = 10;
+        trajectory.offsets.push_back(offset);
+    }
+    std::vector<std::size_t> offset_indices(trajectory.offsets.size());
+    std::iota(offset_indices.begin(), offset_indices.end(), 0);
+    auto exact_points = clt.trajectory_2_map_points(trajectory, offset_indices);
+    ASSERT_EQ(trajectory.offsets.size() + 1, exact_points.size());
+    // Only the requested offsets are converted, indices past the last offset are ignored
+    auto sampled_points = clt.trajectory_2_map_points(trajectory, {9, 19, 49, 50});
+    ASSERT_EQ(4, sampled_points.size());
+    ASSERT_NEAR(0, (exact_points[0] - sampled_points[0]).norm(), 1e-9);
+    ASSERT_NEAR(0, (exact_points[10] - sampled_points[1]).norm(), 1e-9);
+    ASSERT_NEAR(0, (exact_points[20] - sampled_points[2]).norm(), 1e-9);
+    ASSERT_NEAR(0, (exact_points[50] - sampled_points[3]).norm(), 1e-9);
+
+    // A linearization deviating at most 0 m cannot be enabled
+    ASSERT_FALSE(clt.init_linearized_projection(200, 0));
+    ASSERT_FALSE(clt.init_linearized_projection(0));
+    ASSERT_TRUE(clt.init_linearized_projection(200));
+    auto linearized_points = clt.trajectory_2_map_points(trajectory, offset_indices);
+    ASSERT_EQ(exact_points.size(), linearized_points.size());
+    for (std::size_t i = 0; i < exact_points.size(); i++)
+    {
+        ASSERT_NEAR(0, (exact_points[i] - linearized_points[i]).norm(), 0.005);
+    }
+    ASSERT_NEAR(0, (exact_points.front() - clt.ecef_2_map_point(trajectory.location.ecef_x, trajectory.location.ecef_y, trajectory.location.ecef_z)).norm(), 0.005);
+    // The current lanelet is unchanged
+    ASSERT_EQ(167, clt.get_cur_lanelet_by_point_and_direction(linearized_points.front(), "", trajectory).id());
+}
+
 TEST(test_message_lanelet2_translation, distance2_cur_lanelet_end_point)
 {
     message_services::message_translations::message_lanelet2_translation clt("../../sample_map/town01_vector_map_test.osm");
@@ -68,17 +157,17 @@ TEST(test_message_lanelet2_translation, distance2_cur_lanelet_end_point)
     //Positions within the entry lanelet
     point3d = clt.gps_2_map_point(48.9977278, 8.0026431, 0);
 
-    ASSERT_NEAR(5.528, clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(167), point3d), clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
     // Futher location in entry lane
     point3d = clt.gps_2_map_point(48.9976419, 8.0026431, 0);
-    ASSERT_NEAR(15.07, clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(167), point3d), clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
     // Same location in entry lane with direction
     point3d = clt.gps_2_map_point(48.9976419, 8.0026431, 0);
-    ASSERT_NEAR(15.07, clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(167),  "right", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(167), point3d), clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(167),  "right", trajectory), 0.01);
 
     //Position within the departure lanelet
     point3d = clt.gps_2_map_point(48.9976419,8.0025901, 0);
-    ASSERT_NEAR(174.876, clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(164), "", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(164), point3d), clt.distance2_cur_lanelet_end(point3d, clt.get_lanelet_by_id(164), "", trajectory), 0.01);
 
    
 }
@@ -100,17 +189,17 @@ TEST(test_message_lanelet2_translation, distance2_cur_lanelet_end)
     //Positions within the entry lanelet
     point3d = clt.gps_2_map_point(48.9977278, 8.0026431, 0);
 
-    ASSERT_NEAR(5.528, clt.distance2_cur_lanelet_end(48.9977278, 8.0026431, 0, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(167), point3d), clt.distance2_cur_lanelet_end(48.9977278, 8.0026431, 0, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
     // Futher location in entry lane
     point3d = clt.gps_2_map_point(48.9976419, 8.0026431, 0);
-    ASSERT_NEAR(15.07, clt.distance2_cur_lanelet_end(48.9976419, 8.0026431, 0, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(167), point3d), clt.distance2_cur_lanelet_end(48.9976419, 8.0026431, 0, clt.get_lanelet_by_id(167), "", trajectory), 0.01);
     // Same location in entry lane with direction
     point3d = clt.gps_2_map_point(48.9976419, 8.0026431, 0);
-    ASSERT_NEAR(15.07, clt.distance2_cur_lanelet_end(48.9976419, 8.0026431, 0, clt.get_lanelet_by_id(167),  "right", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(167), point3d), clt.distance2_cur_lanelet_end(48.9976419, 8.0026431, 0, clt.get_lanelet_by_id(167),  "right", trajectory), 0.01);
 
     //Position within the departure lanelet
     point3d = clt.gps_2_map_point(48.9976419,8.0025901, 0);
-    ASSERT_NEAR(174.876, clt.distance2_cur_lanelet_end(48.9976419,8.0025901, 0, clt.get_lanelet_by_id(164), "", trajectory), 0.01);
+    ASSERT_NEAR(remaining_centerline_length(clt.get_lanelet_by_id(164), point3d), clt.distance2_cur_lanelet_end(48.9976419,8.0025901, 0, clt.get_lanelet_by_id(164), "", trajectory), 0.01);
 }
 
 TEST(test_message_lanelet2_translation, get_lanelet_types_ids)
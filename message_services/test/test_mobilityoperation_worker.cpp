@@ -41,4 +41,57 @@ TEST(test_mobilityoperation_worker, pop_cur_element_from_list)
     ASSERT_EQ("5.000000", mobilityoperation_w_obj.get_curr_list().front().get_value_from_strategy_params("min_gap"));
     ASSERT_EQ("9999", mobilityoperation_w_obj.get_curr_list().front().get_value_from_strategy_params("depart_pos"));
     ASSERT_EQ("straight", mobilityoperation_w_obj.get_curr_list().front().get_value_from_strategy_params("turn_direction"));
-}
\ No newline at end of file
+}
+
+TEST(test_mobilityoperation_worker, correlation_keys)
+{
+    message_services::workers::mobilityoperation_worker mobilityoperation_w_obj;
+    std::string mobilityoperation_json_str_1 = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\"}, \"strategy\": \"NA\",\"strategy_params\": \"msg_count: 12, sec_mark: 16323, access: 0\"}";
+    std::string mobilityoperation_json_str_2 = "{\"metadata\": {\"timestamp\" : \"1632679658\",\"hostStaticId\": \"DOT-508\",\"hostBSMId\": \"bsmid2\"}, \"strategy\": \"NA\",\"strategy_params\": \"msg_count: 12, access: 0\"}";
+    message_services::models::mobilityoperation mo_1;
+    message_services::models::mobilityoperation mo_2;
+    ASSERT_TRUE(mobilityoperation_w_obj.parse_incoming_msg(mobilityoperation_json_str_1, mo_1));
+    ASSERT_TRUE(mobilityoperation_w_obj.parse_incoming_msg(mobilityoperation_json_str_2, mo_2));
+
+    message_services::models::correlation_key_t bsm_msg_key;
+    ASSERT_TRUE(mo_1.get_bsm_msg_key(bsm_msg_key));
+    ASSERT_EQ(message_services::models::make_bsm_msg_key(message_services::models::pack_correlation_id("bsmid1"), 12, 16323), bsm_msg_key);
+    ASSERT_EQ(message_services::models::make_sender_timestamp_key(message_services::models::pack_correlation_id("DOT-507"), 1632679), mo_1.get_sender_timestamp_key(1000));
+    // No sec_mark
+    ASSERT_FALSE(mo_2.get_bsm_msg_key(bsm_msg_key));
+
+    // Ids longer than 8 characters are hashed and do not collide with packed ids
+    ASSERT_NE(message_services::models::pack_correlation_id("vehicle_id_1"), message_services::models::pack_correlation_id("vehicle_id_2"));
+    ASSERT_NE(message_services::models::pack_correlation_id("DOT-507"), message_services::models::pack_correlation_id("DOT-5070"));
+}
+
+TEST(test_mobilityoperation_worker, typed_strategy_params)
+{
+    message_services::models::mobilityoperation mo;
+    mo.setStrategy_params("msg_count: 12,access: 1, max_accel: 1.500000, max_decel:-1.000000, depart_pos: 9999x,turn_direction:straight");
+    long access = 0;
+    double max_decel = 0;
+    ASSERT_TRUE(mo.get_strategy_param("access", access));
+    ASSERT_EQ(1, access);
+    ASSERT_TRUE(mo.get_strategy_param("max_decel", max_decel));
+    ASSERT_DOUBLE_EQ(-1.0, max_decel);
+
+    std::string_view turn_direction;
+    ASSERT_TRUE(mo.find_strategy_param("turn_direction", turn_direction));
+    ASSERT_EQ("straight", turn_direction);
+
+    // Invalid or missing values are reported and leave the output untouched
+    long depart_pos = 0;
+    double turn_direction_num = 0;
+    ASSERT_FALSE(mo.get_strategy_param("depart_pos", depart_pos));
+    ASSERT_FALSE(mo.get_strategy_param("turn_direction", turn_direction_num));
+    ASSERT_FALSE(mo.get_strategy_param("min_gap", depart_pos));
+    ASSERT_EQ(0, depart_pos);
+
+    // Copies keep a valid index
+    message_services::models::mobilityoperation mo_copy = mo;
+    mo.setStrategy_params("");
+    ASSERT_FALSE(mo.get_strategy_param("access", access));
+    ASSERT_TRUE(mo_copy.get_strategy_param("access", access));
+    ASSERT_EQ(1, access);
+}
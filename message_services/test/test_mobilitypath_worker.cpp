@@ -32,19 +32,21 @@ TEST(test_mobilitypath_worker, pop_cur_element_from_list)
     mobilitypath_w_obj.process_incoming_msg(mobilitypath_json_str_2);
     mobilitypath_w_obj.process_incoming_msg(mobilitypath_json_str_3);
     ASSERT_EQ(3, mobilitypath_w_obj.get_curr_map().size());
-    mobilitypath_w_obj.get_curr_map().erase("DOT-5071632679");
+    mobilitypath_w_obj.get_curr_map().erase(message_services::models::make_sender_timestamp_key(message_services::models::pack_correlation_id("DOT-507"), 1632679));
     ASSERT_EQ(2, mobilitypath_w_obj.get_curr_map().size());
     // ASSERT_EQ("00000000-0000-0000-0000-000000000000", mobilitypath_w_obj.get_curr_map().find("DOT-50716326798")->second.getHeader().plan_id);
-    ASSERT_EQ("DOT-508", mobilitypath_w_obj.get_curr_map().begin()->second.getHeader().sender_id);
-    ASSERT_EQ("bsmXXXid", mobilitypath_w_obj.get_curr_map().begin()->second.getHeader().sender_bsm_id);
-    ASSERT_EQ("", mobilitypath_w_obj.get_curr_map().begin()->second.getHeader().recipient_id);
-    ASSERT_EQ(1632689758, mobilitypath_w_obj.get_curr_map().begin()->second.getHeader().timestamp);
-    std::cout << mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().offsets.front().offset_x;
-    ASSERT_EQ(122, mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().offsets.begin()->offset_x);
-    ASSERT_EQ(1, mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().offsets.begin()->offset_y);
-    ASSERT_EQ(0, mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().offsets.begin()->offset_z);
-    ASSERT_EQ(122, mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().location.ecef_x);
-    ASSERT_EQ(1, mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().location.ecef_y);
-    ASSERT_EQ(0, mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().location.ecef_z);
-    ASSERT_EQ(1632679657, mobilitypath_w_obj.get_curr_map().begin()->second.getTrajectory().location.timestamp);
+    auto mp_itr = mobilitypath_w_obj.get_curr_map().find(message_services::models::make_sender_timestamp_key(message_services::models::pack_correlation_id("DOT-508"), 1632689));
+    ASSERT_NE(mobilitypath_w_obj.get_curr_map().end(), mp_itr);
+    ASSERT_EQ("DOT-508", mp_itr->second.getHeader().sender_id);
+    ASSERT_EQ("bsmXXXid", mp_itr->second.getHeader().sender_bsm_id);
+    ASSERT_EQ("", mp_itr->second.getHeader().recipient_id);
+    ASSERT_EQ(1632689758, mp_itr->second.getHeader().timestamp);
+    std::cout << mp_itr->second.getTrajectory().offsets.front().offset_x;
+    ASSERT_EQ(122, mp_itr->second.getTrajectory().offsets.begin()->offset_x);
+    ASSERT_EQ(1, mp_itr->second.getTrajectory().offsets.begin()->offset_y);
+    ASSERT_EQ(0, mp_itr->second.getTrajectory().offsets.begin()->offset_z);
+    ASSERT_EQ(122, mp_itr->second.getTrajectory().location.ecef_x);
+    ASSERT_EQ(1, mp_itr->second.getTrajectory().location.ecef_y);
+    ASSERT_EQ(0, mp_itr->second.getTrajectory().location.ecef_z);
+    ASSERT_EQ(1632679657, mp_itr->second.getTrajectory().location.timestamp);
 }
\ No newline at end of file
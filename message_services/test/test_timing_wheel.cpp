@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+#include "timing_wheel.h"
+
+#include <string>
+
+TEST(test_timing_wheel, advance)
+{
+    message_services::workers::timing_wheel<std::string> wheel(100, 10);
+    std::vector<std::string> expired;
+    auto on_expired = [&expired](const std::string &key)
+    { expired.push_back(key); };
+    wheel.schedule("a", 1000);
+    wheel.schedule("b", 1055);
+    // Deadline beyond the span of the wheel
+    wheel.schedule("c", 1500);
+    EXPECT_EQ(3, wheel.size());
+
+    wheel.advance(999, on_expired);
+    EXPECT_TRUE(expired.empty());
+    wheel.advance(1000, on_expired);
+    ASSERT_EQ(1, expired.size());
+    EXPECT_EQ("a", expired.back());
+    wheel.advance(1059, on_expired);
+    ASSERT_EQ(2, expired.size());
+    EXPECT_EQ("b", expired.back());
+    // Wheel turned past the slot of c without expiring it
+    wheel.advance(1200, on_expired);
+    EXPECT_EQ(2, expired.size());
+    EXPECT_EQ(1, wheel.size());
+    wheel.advance(1500, on_expired);
+    ASSERT_EQ(3, expired.size());
+    EXPECT_EQ("c", expired.back());
+    EXPECT_EQ(0, wheel.size());
+
+    // Deadline already passed expires on next advance
+    wheel.schedule("d", 1400);
+    wheel.advance(1501, on_expired);
+    ASSERT_EQ(4, expired.size());
+    EXPECT_EQ("d", expired.back());
+
+    wheel.schedule("e", 1600);
+    wheel.clear();
+    EXPECT_EQ(0, wheel.size());
+    wheel.advance(2000, on_expired);
+    EXPECT_EQ(4, expired.size());
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "vsi_correlation_engine.h"
+
+namespace
+{
+    const std::string bsm_json_str = "{\"core_data\": {\"id\": \"bsmid1\", \"lat\":\"38.956287\",\"long\" :\"-77.150492\",\"elev\" :\"72\",\"sec_mark\": \"16323\",\"msg_count\": \"12\", \"speed\": \"13\" ,\"size\": { \"length\": \"12\"}}}";
+    const std::string mp_json_str = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\"}, \"trajectory\": { \"location\": {\"ecefX\": 122, \"ecef_y\": 1,\"ecefZ\": 0}}}";
+    const std::string mo_json_str = "{\"metadata\": {\"timestamp\" : \"1632679657\",\"hostStaticId\": \"DOT-507\",\"hostBSMId\": \"bsmid1\"}, \"strategy\": \"NA\",\"strategy_params\": \"msg_count: 12, sec_mark: 16323, access: 0, max_accel: 1.500000, max_decel:-1.000000,react_time: 4.500000, min_gap: 5.000000, depart_pos: 9999,turn_direction:straight\"}";
+
+    message_services::services::vsi_correlation_engine create_engine()
+    {
+        message_services::services::vsi_correlation_engine engine(std::make_shared<message_services::workers::bsm_worker>(),
+                                                                  std::make_shared<message_services::workers::mobilitypath_worker>(),
+                                                                  std::make_shared<message_services::workers::mobilityoperation_worker>());
+        engine.set_clean_queue_in_ms(1000);
+        return engine;
+    }
+}
+
+TEST(test_vsi_correlation_engine, mo_arrives_last)
+{
+    auto engine = create_engine();
+    std::vector<message_services::services::vsi_message_bucket_t> completed;
+    engine.on_message(message_services::services::correlation_msg_type::BSM, bsm_json_str, completed);
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_PATH, mp_json_str, completed);
+    ASSERT_TRUE(completed.empty());
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_OPERATION, mo_json_str, completed);
+    ASSERT_EQ(1, completed.size());
+    EXPECT_EQ("DOT-507", completed.front().mo.getHeader().sender_id);
+    EXPECT_EQ("bsmid1", completed.front().bsm.getCore_data().temprary_id);
+    EXPECT_EQ(1632679657, completed.front().mp.getHeader().timestamp);
+    EXPECT_EQ(0, engine.get_pending_count());
+}
+
+TEST(test_vsi_correlation_engine, mo_arrives_first)
+{
+    auto engine = create_engine();
+    std::vector<message_services::services::vsi_message_bucket_t> completed;
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_OPERATION, mo_json_str, completed);
+    EXPECT_EQ(1, engine.get_pending_count());
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_PATH, mp_json_str, completed);
+    ASSERT_TRUE(completed.empty());
+    // Last message of the triple completes the pending MobilityOperation
+    engine.on_message(message_services::services::correlation_msg_type::BSM, bsm_json_str, completed);
+    ASSERT_EQ(1, completed.size());
+    EXPECT_EQ(0, engine.get_pending_count());
+
+    // BSM and MobilityPath are consumed by the correlation
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_OPERATION, mo_json_str, completed);
+    EXPECT_EQ(1, completed.size());
+    EXPECT_EQ(1, engine.get_pending_count());
+}
+
+TEST(test_vsi_correlation_engine, expire)
+{
+    auto engine = create_engine();
+    std::vector<message_services::services::vsi_message_bucket_t> completed;
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_OPERATION, mo_json_str, completed);
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_PATH, mp_json_str, completed);
+    std::time_t cur_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    engine.expire(cur_timestamp);
+    EXPECT_EQ(1, engine.get_pending_count());
+    engine.expire(cur_timestamp + 2000);
+    EXPECT_EQ(0, engine.get_pending_count());
+    engine.on_message(message_services::services::correlation_msg_type::BSM, bsm_json_str, completed);
+    EXPECT_TRUE(completed.empty());
+
+    engine.on_message(message_services::services::correlation_msg_type::MOBILITY_OPERATION, mo_json_str, completed);
+    engine.clear_state();
+    EXPECT_EQ(0, engine.get_pending_count());
+}
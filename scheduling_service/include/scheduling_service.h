@@ -32,6 +32,8 @@ namespace scheduling_service{
         std::string consumer_topic;
         std::string producer_topic;
         std::string spat_topic;
+        // Maximum number of status and intent messages applied to the vehicle list under a single lock acquisition.
+        size_t consumer_batch_size = 100;
 
         std::shared_ptr<streets_vehicles::vehicle_list> vehicle_list_ptr;
         std::shared_ptr<streets_vehicle_scheduler::vehicle_scheduler> scheduler_ptr;
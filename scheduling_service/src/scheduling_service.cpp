@@ -12,9 +12,19 @@ namespace scheduling_service{
             this -> group_id = streets_service::streets_configuration::get_string_config("group_id");
             this -> consumer_topic = streets_service::streets_configuration::get_string_config("consumer_topic");
             this -> producer_topic = streets_service::streets_configuration::get_string_config("producer_topic");
+            this -> consumer_batch_size = streets_service::streets_configuration::get_int_config("consumer_batch_size");
+
+            bool consumer_seek_to_latest = streets_service::streets_configuration::get_boolean_config("consumer_seek_to_latest");
+            int consumer_max_message_age_ms = streets_service::streets_configuration::get_int_config("consumer_max_message_age_ms");
 
             consumer_worker = client->create_consumer(bootstrap_server, consumer_topic, group_id);
+            // Stale status and intent is useless for scheduling. Skip backlog after restarts and rebalances.
+            consumer_worker->set_seek_to_latest(consumer_seek_to_latest);
+            consumer_worker->set_max_message_age(consumer_max_message_age_ms);
             producer_worker  = client->create_producer(bootstrap_server, producer_topic);
+            // Never block scheduling thread on the broker. A newer schedule supersedes any queued schedule.
+            producer_worker->set_async(true);
+            producer_worker->set_queue_full_policy(kafka_clients::queue_full_policy::DROP_QUEUED);
 
             if(!consumer_worker->init())
             {
@@ -48,6 +58,8 @@ namespace scheduling_service{
             if ( streets_service::streets_configuration::get_string_config("intersection_type").compare("signalized_intersection") == 0 ) {
                 this -> spat_topic = streets_service::streets_configuration::get_string_config("spat_topic");
                 spat_consumer_worker = client->create_consumer(bootstrap_server, spat_topic, group_id);
+                spat_consumer_worker->set_seek_to_latest(consumer_seek_to_latest);
+                spat_consumer_worker->set_max_message_age(consumer_max_message_age_ms);
                 if(!spat_consumer_worker->init())
                 {
                     SPDLOG_CRITICAL("kafka consumer initialize error");
@@ -178,11 +190,15 @@ namespace scheduling_service{
         while (consumer_worker->is_running()) 
         {
             
-            const std::string payload = consumer_worker->consume(1000);
-            if(payload.length() != 0 && vehicle_list_ptr)
+            const std::vector<kafka_clients::kafka_message> batch = consumer_worker->consume_batch(consumer_batch_size, 1000);
+            if(!batch.empty() && vehicle_list_ptr)
             {                
-
-                vehicle_list_ptr->process_update(payload);
+                std::vector<std::string> updates;
+                updates.reserve(batch.size());
+                for (const auto &message : batch) {
+                    updates.emplace_back(message.payload());
+                }
+                vehicle_list_ptr->process_updates(updates);
     
             }
         }
@@ -196,11 +212,11 @@ namespace scheduling_service{
         SPDLOG_INFO("Starting spat consumer thread.");
         while (spat_consumer_worker->is_running()) 
         {  
-            const std::string spat_msg = spat_consumer_worker->consume(1000);
-            if(spat_msg.length() != 0 && spat_ptr)
+            const kafka_clients::kafka_message spat_msg = spat_consumer_worker->consume_message(1000);
+            if(!spat_msg.empty() && spat_ptr)
             {                
                 try {
-                    spat_ptr->fromJson(spat_msg);
+                    spat_ptr->fromJson(std::string(spat_msg.payload()));
                 }
                 catch(const signal_phase_and_timing::signal_phase_and_timing_exception &ex) {
                     SPDLOG_ERROR("Failure in reading the spat message : {0}", ex.what());
@@ -233,7 +249,8 @@ namespace scheduling_service{
             auto next_schedule_time_epoch = std::chrono::system_clock::now() + std::chrono::milliseconds(scheduling_delta);
 
             
-            veh_map = vehicle_list_ptr -> get_vehicles();
+            // Copy of the latest vehicle list snapshot, taken without blocking vehicle updates
+            veh_map = vehicle_list_ptr -> get_snapshot() -> copy_vehicles();
             try {
                 auto int_schedule = _scheduling_worker->schedule_vehicles(veh_map, scheduler_ptr);
                 if ( streets_service::streets_configuration::get_boolean_config("enable_schedule_logging") ) {
@@ -244,7 +261,7 @@ namespace scheduling_service{
                 }
                 std::string msg_to_send = int_schedule->toJson();
                 /* produce the scheduling plan to kafka */
-                producer_worker->send(msg_to_send);
+                producer_worker->send(std::move(msg_to_send));
             }
             catch( const streets_vehicle_scheduler::scheduling_exception &e) {
                 SPDLOG_ERROR("Scheduling Exception: {0}",e.what());
@@ -84,7 +84,7 @@ TEST_F(all_stop_scheduling_worker_test, schedule_vehicles)
     veh_dv._entry_lane_id = 163;
     veh_dv._link_id = 160;
     veh_dv._exit_lane_id = 164;
-    veh_dv._direction = "right";
+    veh_dv._direction = streets_vehicles::turn_direction::RIGHT;
     veh_dv._departure_position = 1;
     veh_dv._access = true;
     veh_dv._actual_st = current_timestamp - 3000;
@@ -103,7 +103,7 @@ TEST_F(all_stop_scheduling_worker_test, schedule_vehicles)
     veh_rdv1._entry_lane_id = 171;
     veh_rdv1._link_id = 165;
     veh_rdv1._exit_lane_id = 164;
-    veh_rdv1._direction = "straight";
+    veh_rdv1._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_rdv1._departure_position = 2;
     veh_rdv1._actual_st = current_timestamp - 1000;
 
@@ -120,7 +120,7 @@ TEST_F(all_stop_scheduling_worker_test, schedule_vehicles)
     veh_rdv2._entry_lane_id = 167;
     veh_rdv2._link_id = 169;
     veh_rdv2._exit_lane_id = 168;
-    veh_rdv2._direction = "straight";
+    veh_rdv2._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_rdv2._departure_position = 3;
     veh_rdv2._actual_st = current_timestamp - 1000;
 
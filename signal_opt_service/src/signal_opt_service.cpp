@@ -168,7 +168,7 @@ namespace signal_opt_service
 
         while ( dpp_producer->is_running() ) {
             SPDLOG_DEBUG("Signal Optimization iteration!");
-            if ( !_vehicle_list_ptr->get_vehicles().empty() ) {
+            if ( !_vehicle_list_ptr->get_snapshot()->vehicles.empty() ) {
                 streets_desired_phase_plan::streets_desired_phase_plan spat_dpp;
                 try
                 {
@@ -234,7 +234,7 @@ namespace signal_opt_service
                         if (!optimal_dpp.desired_phase_plan.empty()) {
                             std::string msg_to_send = optimal_dpp.toJson();
                             /* produce the optimal desired phase plan to kafka */
-                            dpp_producer->send(msg_to_send);
+                            dpp_producer->send(std::move(msg_to_send));
                             prev_future_move_group_count = current_future_move_group_count;
                             new_dpp_generated = true;
                         }
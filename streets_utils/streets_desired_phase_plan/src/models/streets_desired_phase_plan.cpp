@@ -2,6 +2,26 @@
 
 namespace streets_desired_phase_plan
 {
+    namespace
+    {
+        /**
+         * @brief rapidjson output stream writing the desired phase plan JSON straight into the returned std::string.
+         */
+        class string_output_stream
+        {
+        public:
+            typedef char Ch;
+
+            explicit string_output_stream(std::string &str) : str_(str) {}
+
+            void Put(Ch c) { str_.push_back(c); }
+
+            void Flush() {}
+
+        private:
+            std::string &str_;
+        };
+    }
 
     std::string streets_desired_phase_plan::toJson() const
     {
@@ -29,17 +49,18 @@ namespace streets_desired_phase_plan
         }
         streets_desired_phase_plan_value.AddMember("desired_phase_plan", desired_phase_plan_value, allocator);
 
-        rapidjson::StringBuffer buffer;
+        std::string json;
         try
         {
-            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            string_output_stream os(json);
+            rapidjson::Writer<string_output_stream> writer(os);
             streets_desired_phase_plan_value.Accept(writer);
         }
         catch (const std::exception &e)
         {
             throw streets_desired_phase_plan_exception(e.what());
         }
-        return buffer.GetString();
+        return json;
     }
 
     void streets_desired_phase_plan::fromJson(const std::string &json)
@@ -44,8 +44,9 @@ namespace streets_signal_optimization
                 // Add vehicle schedules from all_schedule_ptr for vehicle that are in SO area.
                 auto schedule_ptr = std::make_shared<streets_vehicle_scheduler::signalized_intersection_schedule>();
                 schedule_ptr->timestamp = all_schedule_ptr->timestamp;
+                auto veh_list_snapshot = veh_list_ptr->get_snapshot();
                 for (const auto& veh_sched : all_schedule_ptr->vehicle_schedules) {
-                    if (veh_sched.state == streets_vehicles::vehicle_state::EV && veh_list_ptr->get_vehicles().at(veh_sched.v_id)._cur_distance <= so_radius) {
+                    if (veh_sched.state == streets_vehicles::vehicle_state::EV && veh_list_snapshot->vehicles->at(veh_sched.v_id)->_cur_distance <= so_radius) {
                         schedule_ptr->vehicle_schedules.push_back(veh_sched);
                     }
                 }
@@ -94,7 +95,8 @@ namespace streets_signal_optimization
         scheduler_ptr->set_spat(local_spat_ptr);
         scheduler_ptr->set_initial_green_buffer(initial_green_buffer);
         scheduler_ptr->set_final_green_buffer(final_green_buffer);
-        auto vehicles = veh_list_ptr->get_vehicles();
+        // The scheduler modifies the vehicle map, schedule a copy of the latest snapshot
+        auto vehicles = veh_list_ptr->get_snapshot()->copy_vehicles();
         all_schedule_ptr->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
         scheduler_ptr->schedule_vehicles(vehicles, all_schedule_ptr);
     }
@@ -389,7 +389,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev_test._entry_lane_id = 3;
     veh_ev_test._link_id = 13;
     veh_ev_test._exit_lane_id = 7;
-    veh_ev_test._direction = "straight";
+    veh_ev_test._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     std::unordered_map<std::string, vehicle> veh_list_max_green_test;
     veh_list_max_green_test.insert({{veh_ev_test._id, veh_ev_test}});
@@ -426,7 +426,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_dv._entry_lane_id = 1;
     veh_dv._link_id = 9;
     veh_dv._exit_lane_id = 5;
-    veh_dv._direction = "right";
+    veh_dv._direction = streets_vehicles::turn_direction::RIGHT;
     veh_dv._actual_et = current_time - 2000;
 
     vehicle veh_ev1;
@@ -445,7 +445,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev1._entry_lane_id = 1;
     veh_ev1._link_id = 9;
     veh_ev1._exit_lane_id = 5;
-    veh_ev1._direction = "straight";
+    veh_ev1._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev2;
     veh_ev2._id = "TEST_EV_02";
@@ -463,7 +463,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev2._entry_lane_id = 1;
     veh_ev2._link_id = 9;
     veh_ev2._exit_lane_id = 5;
-    veh_ev2._direction = "straight";
+    veh_ev2._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev3;
     veh_ev3._id = "TEST_EV_03";
@@ -481,7 +481,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev3._entry_lane_id = 1;
     veh_ev3._link_id = 9;
     veh_ev3._exit_lane_id = 5;
-    veh_ev3._direction = "straight";
+    veh_ev3._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev4;
     veh_ev4._id = "TEST_EV_04";
@@ -499,7 +499,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev4._entry_lane_id = 1;
     veh_ev4._link_id = 9;
     veh_ev4._exit_lane_id = 5;
-    veh_ev4._direction = "straight";
+    veh_ev4._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev5;
     veh_ev5._id = "TEST_EV_05";
@@ -517,7 +517,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev5._entry_lane_id = 1;
     veh_ev5._link_id = 9;
     veh_ev5._exit_lane_id = 5;
-    veh_ev5._direction = "straight";
+    veh_ev5._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev6;
     veh_ev6._id = "TEST_EV_06";
@@ -535,7 +535,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev6._entry_lane_id = 1;
     veh_ev6._link_id = 9;
     veh_ev6._exit_lane_id = 5;
-    veh_ev6._direction = "straight";
+    veh_ev6._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev7;
     veh_ev7._id = "TEST_EV_07";
@@ -553,7 +553,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev7._entry_lane_id = 4;
     veh_ev7._link_id = 15;
     veh_ev7._exit_lane_id = 8;
-    veh_ev7._direction = "straight";
+    veh_ev7._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev8;
     veh_ev8._id = "TEST_EV_08";
@@ -571,7 +571,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev8._entry_lane_id = 4;
     veh_ev8._link_id = 15;
     veh_ev8._exit_lane_id = 8;
-    veh_ev8._direction = "straight";
+    veh_ev8._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev9;
     veh_ev9._id = "TEST_EV_09";
@@ -589,7 +589,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev9._entry_lane_id = 4;
     veh_ev9._link_id = 15;
     veh_ev9._exit_lane_id = 8;
-    veh_ev9._direction = "straight";
+    veh_ev9._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev10;
     veh_ev10._id = "TEST_EV_10";
@@ -607,7 +607,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev10._entry_lane_id = 3;
     veh_ev10._link_id = 13;
     veh_ev10._exit_lane_id = 7;
-    veh_ev10._direction = "straight";
+    veh_ev10._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev11;
     veh_ev11._id = "TEST_EV_11";
@@ -625,7 +625,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev11._entry_lane_id = 3;
     veh_ev11._link_id = 13;
     veh_ev11._exit_lane_id = 7;
-    veh_ev11._direction = "straight";
+    veh_ev11._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev12;
     veh_ev12._id = "TEST_EV_12";
@@ -643,7 +643,7 @@ TEST(test_streets_desired_phase_plan_generator, test_generate_desired_phase_plan
     veh_ev12._entry_lane_id = 3;
     veh_ev12._link_id = 13;
     veh_ev12._exit_lane_id = 7;
-    veh_ev12._direction = "straight";
+    veh_ev12._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     std::unordered_map<std::string, vehicle> veh_list;
     veh_list.insert({{veh_dv._id, veh_dv}, {veh_ev1._id, veh_ev1}, {veh_ev2._id, veh_ev2}, {veh_ev3._id, veh_ev3}, {veh_ev4._id, veh_ev4}, {veh_ev5._id, veh_ev5}, {veh_ev6._id, veh_ev6}, {veh_ev7._id, veh_ev7}, {veh_ev8._id, veh_ev8}, {veh_ev9._id, veh_ev9}, {veh_ev10._id, veh_ev10}, {veh_ev11._id, veh_ev11}, {veh_ev12._id, veh_ev12}});
@@ -2,6 +2,27 @@
 
 namespace signal_phase_and_timing{
 
+    namespace {
+        /**
+         * @brief rapidjson output stream appending to a std::string, so the SPaT JSON is returned without copying it
+         * out of a rapidjson::StringBuffer.
+         */
+        class string_output_stream
+        {
+        public:
+            typedef char Ch;
+
+            explicit string_output_stream(std::string &str) : str_(str) {}
+
+            void Put(Ch c) { str_.push_back(c); }
+
+            void Flush() {}
+
+        private:
+            std::string &str_;
+        };
+    }
+
     std::string spat::toJson() {
         rapidjson::Document doc;
         auto allocator = doc.GetAllocator();
@@ -21,15 +42,16 @@ namespace signal_phase_and_timing{
         }else {
             throw signal_phase_and_timing_exception("SPaT message is missing required intersections property!");
         }
-        rapidjson::StringBuffer buffer;
+        std::string json;
         try {
-            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            string_output_stream os(json);
+            rapidjson::Writer<string_output_stream> writer(os);
             spat.Accept(writer);
         }
         catch( const std::exception &e ) {
             throw signal_phase_and_timing_exception(e.what());
         }
-        return buffer.GetString();
+        return json;
     }
 
     void spat::fromJson(const std::string &json )  {
@@ -2,6 +2,26 @@
 
 namespace streets_tsc_configuration
 {
+    namespace
+    {
+        /**
+         * @brief rapidjson output stream appending to the std::string returned by tsc_configuration_state::toJson.
+         */
+        class string_output_stream
+        {
+        public:
+            typedef char Ch;
+
+            explicit string_output_stream(std::string &str) : str_(str) {}
+
+            void Put(Ch c) { str_.push_back(c); }
+
+            void Flush() {}
+
+        private:
+            std::string &str_;
+        };
+    }
    
     rapidjson::Value signal_group_configuration::toJson(rapidjson::Document::AllocatorType &allocator) const {
         // Create signal group configuration JSON value
@@ -97,15 +117,16 @@ namespace streets_tsc_configuration
             throw tsc_configuration_state_exception("tsc_configuration_state is missing required tsc configuration information!");
         }
 
-        rapidjson::StringBuffer buffer;
+        std::string json;
         try {
-            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            string_output_stream os(json);
+            rapidjson::Writer<string_output_stream> writer(os);
             config.Accept(writer);
         }
         catch( const std::exception &e ) {
             throw tsc_configuration_state_exception(e.what());
         }
-        return buffer.GetString();
+        return json;
     }
 
     void tsc_configuration_state::fromJson(const std::string &json){
@@ -2,6 +2,8 @@
 
 #include <rapidjson/document.h>
 #include <spdlog/spdlog.h>
+#include <memory>
+#include <vector>
 
 
 
@@ -28,7 +30,34 @@ namespace streets_vehicles {
 		EV=0,RDV=1,DV=2,LV=3,ND=-1
 	};
 	/**
-	 * @brief Data struct for vehicle status and intent information.
+	 * @brief Vehicle turn direction in the intersection. UNKNOWN for directions other than
+	 * "straight", "left" and "right".
+	 * 
+	 */
+	enum class turn_direction{
+		STRAIGHT=0,LEFT=1,RIGHT=2,UNKNOWN=-1
+	};
+	/**
+	 * @brief Convert a status and intent turn direction string to turn_direction.
+	 * 
+	 * @param direction turn direction string.
+	 * @return turn_direction, UNKNOWN for unknown strings.
+	 */
+	inline turn_direction turn_direction_from_string(const std::string &direction) {
+		if ( direction == "straight" ) {
+			return turn_direction::STRAIGHT;
+		}
+		else if ( direction == "left" ) {
+			return turn_direction::LEFT;
+		}
+		else if ( direction == "right" ) {
+			return turn_direction::RIGHT;
+		}
+		return turn_direction::UNKNOWN;
+	}
+	/**
+	 * @brief Data struct for vehicle status and intent information. Vehicles are copied by value
+	 * through the vehicle list and the schedulers, so the future path is shared instead of copied.
 	 * 
 	 */
 	struct vehicle{
@@ -54,7 +83,7 @@ namespace streets_vehicles {
 		/* vehicle's connection link id */
 		int _link_id = 0;
 		/* vehicle turn direction in intersection */
-		std::string _direction;
+		turn_direction _direction = turn_direction::UNKNOWN;
 		/* link lane priority */
 		int _link_priority;
 		/* access to the intersection box */
@@ -77,8 +106,9 @@ namespace streets_vehicles {
 		double _cur_accel = 0.0;
 		/* vehicle's state based on the last update */
 		vehicle_state _cur_state = vehicle_state::ND;
-		/* the estimated future path information of the vehicle */
-		std::vector<future_information> _future_info;
+		/* the estimated future path information of the vehicle, nullptr without update. Immutable and shared between
+		   copies of the vehicle, replace it to change the future path. */
+		std::shared_ptr<const std::vector<future_information>> _future_info;
 
 	};
 }
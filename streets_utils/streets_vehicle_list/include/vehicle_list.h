@@ -4,13 +4,60 @@
 #include "status_intent_processing_exception.h"
 #include "status_intent_processor.h"
 #include "status_intent_processing_exception.h"
+#include <atomic>
 #include <chrono>  
-#include <shared_mutex>
 #include <mutex>
+#include <memory>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <rapidjson/document.h>
 
 
 
 namespace streets_vehicles {
+    // Vehicles by vehicle id, shared between the vehicle list and its snapshots
+    typedef std::unordered_map<std::string, std::shared_ptr<const vehicle>> vehicle_ptr_map;
+
+    /**
+     * @brief Immutable state of the vehicle list. Built by the first get_snapshot() call after a change, so a burst
+     * of updates between two reads builds a single snapshot. The vehicle maps are shared with the vehicle list,
+     * which copies a map before its first change after a snapshot was built. Building a snapshot only copies the
+     * map pointers.
+     */
+    struct vehicle_list_snapshot {
+        // Version of the vehicle list the snapshot was built from
+        uint64_t version = 0;
+        // Vehicles by vehicle id
+        std::shared_ptr<const vehicle_ptr_map> vehicles = std::make_shared<vehicle_ptr_map>();
+        // Vehicles by current lane id. Only lanes with vehicles are present.
+        std::unordered_map<int, std::shared_ptr<const vehicle_ptr_map>> vehicles_by_lane;
+        // Vehicles by current state. Only states with vehicles are present.
+        std::unordered_map<vehicle_state, std::shared_ptr<const vehicle_ptr_map>> vehicles_by_state;
+        // Time in milliseconds since epoch after which the oldest vehicle of the snapshot times out
+        uint64_t expiry_time = std::numeric_limits<uint64_t>::max();
+        /**
+         * @brief Copy the vehicles, e.g. for schedulers that modify the vehicle map.
+         * 
+         * @return std::unordered_map<std::string, vehicle> 
+         */
+        std::unordered_map<std::string, vehicle> copy_vehicles() const;
+        /**
+         * @brief Get the vehicles in a lane without copying them.
+         * 
+         * @param lane_id lanelet2 map lane id.
+         * @return const vehicle_ptr_map& vehicles by vehicle id, empty if no vehicle is in the lane.
+         */
+        const vehicle_ptr_map &get_vehicles_by_lane(const int lane_id) const;
+        /**
+         * @brief Get the vehicles in a state without copying them.
+         * 
+         * @param state vehicle state.
+         * @return const vehicle_ptr_map& vehicles by vehicle id, empty if no vehicle is in the state.
+         */
+        const vehicle_ptr_map &get_vehicles_by_state(const vehicle_state state) const;
+    };
+
     /**
      * @brief Class to store vehicle information for all vehicles in an intersection. Contains pointer
      * to a status_intent_processor which holds business logic to process status and intent vehicle 
@@ -22,17 +69,81 @@ namespace streets_vehicles {
     class vehicle_list   {
 
         private:
-            // Map to store vehicles with vehicle id string as keys
-            std::unordered_map<std::string, vehicle> vehicles;
-            // shared mutex to enable read/write locking (requires C++ > 17)
-            std::shared_mutex vehicle_list_lock;
+            /**
+             * @brief Vehicle map shared with the published snapshots. It is copied before its first change after a
+             * snapshot was published, later changes until the next publish modify the copy.
+             */
+            struct shared_vehicle_map {
+                std::shared_ptr<vehicle_ptr_map> map = std::make_shared<vehicle_ptr_map>();
+                // Value of publish_count when the map was created or copied. The map is shared with a snapshot if
+                // publish_count changed since.
+                uint64_t generation = 0;
+            };
+            // Map to store vehicles with vehicle id string as keys. Vehicles are shared with the published snapshots
+            // and replaced, never modified, on update.
+            shared_vehicle_map vehicles;
+            // Secondary indexes of vehicles by current lane id and by current state, updated with the vehicle map
+            std::unordered_map<int, shared_vehicle_map> vehicles_by_lane;
+            std::unordered_map<vehicle_state, shared_vehicle_map> vehicles_by_state;
+            // Number of published snapshots
+            uint64_t publish_count = 0;
+            // Min-heap (std::greater) of vehicle update times and vehicle ids. Every update pushes an entry, entries
+            // of replaced update times are dropped lazily when they reach the top.
+            std::vector<std::pair<uint64_t, std::string>> update_time_heap;
+            // Serializes writers and snapshot builds. Readers of an up to date snapshot only load it, readers of a stale
+            // snapshot take it to build a new one.
+            std::mutex vehicle_list_lock;
+            // Latest published snapshot, read and written with std::atomic_load/std::atomic_store
+            std::shared_ptr<const vehicle_list_snapshot> snapshot = std::make_shared<vehicle_list_snapshot>();
+            // Incremented with every change of the vehicle map. The snapshot is stale if its version differs.
+            std::atomic<uint64_t> version{0};
             std::shared_ptr<status_intent_processor> processor;
+            /**
+             * @brief Status and intent update parsed without holding the write lock.
+             */
+            struct parsed_update {
+                std::string v_id;
+                rapidjson::Document doc;
+                // False if the update has a JSON parse error or no vehicle id
+                bool is_valid = false;
+            };
+            /**
+             * @brief Get a vehicle map for modification, copying it first if it is shared with a published snapshot.
+             * 
+             * @param shared vehicle map of the vehicle list.
+             * @return vehicle_ptr_map& map not referenced by any snapshot.
+             */
+            vehicle_ptr_map &writable(shared_vehicle_map &shared);
             /**
              * @brief Adds a vehicle to the vehicle map.
              * 
              * @param vehicle to add.
              */
             void add_vehicle(const vehicle &vehicle);
+            /**
+             * @brief Adds a vehicle to the lane and state indexes.
+             * 
+             * @param veh vehicle in the vehicle map.
+             */
+            void index_vehicle(const std::shared_ptr<const vehicle> &veh);
+            /**
+             * @brief Removes a vehicle from the lane and state indexes. Empty index entries are removed.
+             * 
+             * @param veh vehicle in the vehicle map.
+             */
+            void unindex_vehicle(const vehicle &veh);
+            /**
+             * @brief Push the update time of a vehicle to the update time heap. Rebuilds the heap from the vehicle
+             * map if replaced update times make up most of it.
+             * 
+             * @param veh vehicle in the vehicle map.
+             */
+            void push_update_time(const vehicle &veh);
+            /**
+             * @brief Pop entries of removed vehicles and replaced update times from the top of the update time heap.
+             * Afterwards the top is the oldest update time of the vehicle map.
+             */
+            void pop_stale_update_times();
             /**
              * @brief Updates a vehicle in the vehicle map, with new vehicle information.
              * 
@@ -40,35 +151,68 @@ namespace streets_vehicles {
              */
             void update_vehicle(const vehicle &vehicle);
             /**
-             * @brief Removes all vehicles in map that have not been updated in timeout period.
+             * @brief Removes all vehicles in map that have not been updated in timeout period. Only pops timed out
+             * entries from the update time heap, without timed out vehicles this is a single comparison.
              * 
              * @param timeout time in milliseconds from current time after which vehicles will be removed from the vehicle list.
              */
             void purge_old_vehicles(const uint64_t timeout);
+            /**
+             * @brief Parse a JSON status and intent update and read its vehicle id. Does not access the vehicle map,
+             * no lock is required.
+             * 
+             * @param update std::string status and intent JSON vehicle update
+             * @param parsed parsed update, invalid if the update can not be parsed.
+             */
+            void parse_update(const std::string &update, parsed_update &parsed) const;
+            /**
+             * @brief Process a single parsed status and intent update into the vehicle map. Caller must hold
+             * the write lock.
+             * 
+             * @param parsed valid parsed status and intent update
+             */
+            void apply_update(const parsed_update &parsed);
+            /**
+             * @brief Build a snapshot of the current version of the vehicle map and publish it. Shares the vehicle
+             * maps with the snapshot, so it only copies one pointer per lane and state. Afterwards the next change of
+             * each map copies it. Caller must hold the write lock.
+             */
+            void publish_snapshot();
             
             
 
         public:
+            // Minimum number of updates in a batch per parsing thread
+            static constexpr size_t MIN_UPDATES_PER_PARSE_THREAD = 16;
             /**
              * @brief Construct a new vehicle list object
              * 
              */
             vehicle_list() = default;
             /**
-             * @brief Get the vehicles map.
+             * @brief Get the latest snapshot of the vehicle list without copying vehicles. If the vehicle list changed
+             * since the last snapshot or vehicles of the snapshot timed out, the caller takes the write lock, waiting
+             * for a running update, purges timed out vehicles and builds a new snapshot, which copies one pointer per
+             * lane and state. Otherwise it is a single atomic load without a lock.
+             * 
+             * @return std::shared_ptr<const vehicle_list_snapshot> 
+             */
+            std::shared_ptr<const vehicle_list_snapshot> get_snapshot();
+            /**
+             * @brief Get a copy of the vehicles map of the latest snapshot.
              * 
              * @return std::unordered_map<std::string, vehicle> .
              */
             std::unordered_map<std::string, vehicle> get_vehicles();
             /**
-             * @brief Get the vehicles by lane id.
+             * @brief Get copies of the vehicles by lane id. Use get_snapshot()->get_vehicles_by_lane() to avoid copies.
              * 
              * @param lane_id lanelet2 map lane id.
              * @return std::vector<vehicle> 
              */
             std::vector<vehicle> get_vehicles_by_lane(const int lane_id);
             /**
-             * @brief Get the vehicles by state. 
+             * @brief Get copies of the vehicles by state. Use get_snapshot()->get_vehicles_by_state() to avoid copies.
              * 
              * @param state 
              * @return std::vector<vehicle> 
@@ -81,6 +225,14 @@ namespace streets_vehicles {
              * @param update std::string status and intent JSON vehicle update 
              */
             void process_update(const std::string &update);
+            /**
+             * @brief Process a batch of JSON status and intent updates. Updates are parsed without holding the
+             * write lock, in parallel for batches of at least 2 * MIN_UPDATES_PER_PARSE_THREAD updates. They are
+             * then applied in order under a single write lock acquisition and old vehicles are purged once per batch.
+             * 
+             * @param updates std::vector of status and intent JSON vehicle updates
+             */
+            void process_updates(const std::vector<std::string> &updates);
             /**
              * @brief Set the status_intent_processor to allow for customizable update processing.
              * 
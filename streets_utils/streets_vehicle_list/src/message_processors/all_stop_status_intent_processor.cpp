@@ -151,7 +151,7 @@ namespace streets_vehicles {
 		}
 
 		if (payload.FindMember("direction")->value.IsString() ){
-			vehicle._direction = payload["direction"].GetString();
+			vehicle._direction = turn_direction_from_string(payload["direction"].GetString());
 		} else{
 			throw status_intent_processing_exception("The \"direction\" " + vehicle._id + " is missing/incorrect in received update!");
 		}
@@ -257,7 +257,7 @@ namespace streets_vehicles {
 			}
 		}
 		
-		vehicle._future_info = future_info;
+		vehicle._future_info = std::make_shared<std::vector<future_information>>(std::move(future_info));
 	}
 
 	bool all_stop_status_intent_processor::is_vehicle_stopped(const vehicle &vehicle) const {
@@ -1,49 +1,170 @@
 #include "vehicle_list.h"
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <thread>
+
 namespace streets_vehicles {
 
 
-   std::vector<vehicle> vehicle_list::get_vehicles_by_lane( const int lane_id ) {
+    std::unordered_map<std::string, vehicle> vehicle_list_snapshot::copy_vehicles() const {
+        std::unordered_map<std::string, vehicle> vehicles_copy;
+        vehicles_copy.reserve(vehicles->size());
+        for ( const auto &id_vehicle : *vehicles ) {
+            vehicles_copy.emplace(id_vehicle.first, *id_vehicle.second);
+        }
+        return vehicles_copy;
+    }
+
+    const vehicle_ptr_map &vehicle_list_snapshot::get_vehicles_by_lane( const int lane_id ) const {
+        static const vehicle_ptr_map no_vehicles;
+        auto it = vehicles_by_lane.find(lane_id);
+        return it != vehicles_by_lane.end() ? *it->second : no_vehicles;
+    }
+
+    const vehicle_ptr_map &vehicle_list_snapshot::get_vehicles_by_state( const vehicle_state state ) const {
+        static const vehicle_ptr_map no_vehicles;
+        auto it = vehicles_by_state.find(state);
+        return it != vehicles_by_state.end() ? *it->second : no_vehicles;
+    }
+
+    std::vector<vehicle> vehicle_list::get_vehicles_by_lane( const int lane_id ) {
         std::vector<vehicle> vehicles_in_entry_lane;
-        // Read lock
-        std::shared_lock  lock(vehicle_list_lock);
-        for ( auto it = vehicles.begin(); it != vehicles.end(); it ++ ) {
-            vehicle veh =it->second;
-            if ( veh._cur_lane_id == lane_id ) {
-                vehicles_in_entry_lane.push_back(veh);
-            }
+        auto cur_snapshot = get_snapshot();
+        const auto &lane_vehicles = cur_snapshot->get_vehicles_by_lane(lane_id);
+        vehicles_in_entry_lane.reserve(lane_vehicles.size());
+        for ( const auto &id_vehicle : lane_vehicles ) {
+            vehicles_in_entry_lane.push_back(*id_vehicle.second);
         }
         return vehicles_in_entry_lane;
     }
 
     std::vector<vehicle> vehicle_list::get_vehicles_by_state( const vehicle_state state ) {
         std::vector<vehicle> vehicle_in_state;
-        // Read Lock
-        std::shared_lock  lock(vehicle_list_lock);
-        for ( auto it = vehicles.begin(); it != vehicles.end(); it ++ ) {
-            vehicle veh =it->second;
-            if ( veh._cur_state == state ) {
-                vehicle_in_state.push_back(veh);
-            }
+        auto cur_snapshot = get_snapshot();
+        const auto &state_vehicles = cur_snapshot->get_vehicles_by_state(state);
+        vehicle_in_state.reserve(state_vehicles.size());
+        for ( const auto &id_vehicle : state_vehicles ) {
+            vehicle_in_state.push_back(*id_vehicle.second);
         }
         return vehicle_in_state;
     }
 
-    std::unordered_map<std::string,vehicle> vehicle_list::get_vehicles() {
-        // Write Lock
+    std::shared_ptr<const vehicle_list_snapshot> vehicle_list::get_snapshot() {
+        auto cur_snapshot = std::atomic_load(&snapshot);
+        uint64_t cur_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        if ( cur_snapshot->version == version && (cur_time <= cur_snapshot->expiry_time || processor == nullptr) ) {
+            return cur_snapshot;
+        }
+        // Write Lock, snapshot is stale or vehicles of the snapshot timed out
         std::unique_lock  lock(vehicle_list_lock);
-        purge_old_vehicles( processor->get_timeout());
-        return vehicles;
+        if ( processor != nullptr ) {
+            purge_old_vehicles( processor->get_timeout());
+        }
+        cur_snapshot = std::atomic_load(&snapshot);
+        // Another reader may have built the snapshot while waiting for the lock
+        if ( cur_snapshot->version != version || (processor != nullptr && cur_time > cur_snapshot->expiry_time) ) {
+            publish_snapshot();
+            cur_snapshot = std::atomic_load(&snapshot);
+        }
+        return cur_snapshot;
+    }
+
+    std::unordered_map<std::string,vehicle> vehicle_list::get_vehicles() {
+        return get_snapshot()->copy_vehicles();
+    }
+
+    vehicle_ptr_map &vehicle_list::writable(shared_vehicle_map &shared) {
+        if ( shared.generation != publish_count ) {
+            // Published snapshots keep the previous map
+            shared.map = std::make_shared<vehicle_ptr_map>(*shared.map);
+            shared.generation = publish_count;
+        }
+        return *shared.map;
     }
 
     void vehicle_list::add_vehicle(const vehicle &veh) {
-        vehicles.insert(std::pair<std::string, vehicle>({veh._id,veh}));
+        std::shared_ptr<const vehicle> new_veh = std::make_shared<vehicle>(veh);
+        if ( writable(vehicles).insert({veh._id, new_veh}).second ) {
+            index_vehicle(new_veh);
+            push_update_time(veh);
+        }
+    }
+
+    void vehicle_list::push_update_time(const vehicle &veh) {
+        using update_time_t = std::pair<uint64_t, std::string>;
+        if ( update_time_heap.size() > 2 * vehicles.map->size() + 64 ) {
+            // Mostly replaced update times, keep only the current ones
+            update_time_heap.clear();
+            for ( const auto &id_vehicle : *vehicles.map ) {
+                update_time_heap.emplace_back(id_vehicle.second->_cur_time, id_vehicle.first);
+            }
+            std::make_heap(update_time_heap.begin(), update_time_heap.end(), std::greater<update_time_t>());
+            // The map already holds the vehicle
+            return;
+        }
+        update_time_heap.emplace_back(veh._cur_time, veh._id);
+        std::push_heap(update_time_heap.begin(), update_time_heap.end(), std::greater<update_time_t>());
+    }
+
+    void vehicle_list::pop_stale_update_times() {
+        using update_time_t = std::pair<uint64_t, std::string>;
+        while ( !update_time_heap.empty() ) {
+            const auto &oldest = update_time_heap.front();
+            auto it = vehicles.map->find(oldest.second);
+            if ( it != vehicles.map->end() && it->second->_cur_time == oldest.first ) {
+                return;
+            }
+            std::pop_heap(update_time_heap.begin(), update_time_heap.end(), std::greater<update_time_t>());
+            update_time_heap.pop_back();
+        }
+    }
+
+    void vehicle_list::index_vehicle(const std::shared_ptr<const vehicle> &veh) {
+        // New index entries are not shared with any snapshot
+        auto lane_it = vehicles_by_lane.find(veh->_cur_lane_id);
+        if ( lane_it == vehicles_by_lane.end() ) {
+            lane_it = vehicles_by_lane.emplace(veh->_cur_lane_id, shared_vehicle_map{std::make_shared<vehicle_ptr_map>(), publish_count}).first;
+        }
+        writable(lane_it->second)[veh->_id] = veh;
+        auto state_it = vehicles_by_state.find(veh->_cur_state);
+        if ( state_it == vehicles_by_state.end() ) {
+            state_it = vehicles_by_state.emplace(veh->_cur_state, shared_vehicle_map{std::make_shared<vehicle_ptr_map>(), publish_count}).first;
+        }
+        writable(state_it->second)[veh->_id] = veh;
+    }
+
+    void vehicle_list::unindex_vehicle(const vehicle &veh) {
+        auto lane_it = vehicles_by_lane.find(veh._cur_lane_id);
+        if ( lane_it != vehicles_by_lane.end() ) {
+            if ( lane_it->second.map->size() <= 1 ) {
+                vehicles_by_lane.erase(lane_it);
+            }
+            else {
+                writable(lane_it->second).erase(veh._id);
+            }
+        }
+        auto state_it = vehicles_by_state.find(veh._cur_state);
+        if ( state_it != vehicles_by_state.end() ) {
+            if ( state_it->second.map->size() <= 1 ) {
+                vehicles_by_state.erase(state_it);
+            }
+            else {
+                writable(state_it->second).erase(veh._id);
+            }
+        }
     }
 
     void vehicle_list::update_vehicle(const vehicle &vehicle) {
-        auto it = vehicles.find(vehicle._id);
-        if (it != vehicles.end()) {
-            it->second = vehicle;
+        auto &vehicle_map = writable(vehicles);
+        auto it = vehicle_map.find(vehicle._id);
+        if (it != vehicle_map.end()) {
+            // Published snapshots keep the previous vehicle
+            unindex_vehicle(*it->second);
+            it->second = std::make_shared<streets_vehicles::vehicle>(vehicle);
+            index_vehicle(it->second);
+            push_update_time(vehicle);
         }else{
             SPDLOG_WARN("Did not find vehicle {0} to update!", vehicle._id);
         }
@@ -51,48 +172,135 @@ namespace streets_vehicles {
 
 
     void vehicle_list::purge_old_vehicles( const uint64_t timeout ) {
+        using update_time_t = std::pair<uint64_t, std::string>;
         uint64_t timeout_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() - timeout;
-        for ( auto it = vehicles.begin(); it != vehicles.end();  ) {
-            vehicle veh =it->second;
-            if ( veh._cur_time < timeout_time  ) {
+        while ( !update_time_heap.empty() && update_time_heap.front().first < timeout_time ) {
+            std::string v_id = update_time_heap.front().second;
+            std::pop_heap(update_time_heap.begin(), update_time_heap.end(), std::greater<update_time_t>());
+            update_time_heap.pop_back();
+            auto it = vehicles.map->find(v_id);
+            // Entries of replaced update times do not time out the vehicle
+            if ( it != vehicles.map->end() && it->second->_cur_time < timeout_time ) {
+                const vehicle &veh = *it->second;
                 SPDLOG_WARN("Vehicle {0} timed out!Vehicle timestamp {1} < timeout time {2} ", veh._id, veh._cur_time, timeout_time);
-                vehicles.erase(it ++);
+                unindex_vehicle(veh);
+                writable(vehicles).erase(v_id);
+                version++;
+            }
+        }
+
+    }
+
+    void vehicle_list::publish_snapshot() {
+        auto new_snapshot = std::make_shared<vehicle_list_snapshot>();
+        new_snapshot->version = version;
+        new_snapshot->vehicles = vehicles.map;
+        new_snapshot->vehicles_by_lane.reserve(vehicles_by_lane.size());
+        for ( const auto &lane_vehicles : vehicles_by_lane ) {
+            new_snapshot->vehicles_by_lane.emplace(lane_vehicles.first, lane_vehicles.second.map);
+        }
+        new_snapshot->vehicles_by_state.reserve(vehicles_by_state.size());
+        for ( const auto &state_vehicles : vehicles_by_state ) {
+            new_snapshot->vehicles_by_state.emplace(state_vehicles.first, state_vehicles.second.map);
+        }
+        // The maps are shared with the snapshot from now on
+        publish_count++;
+        pop_stale_update_times();
+        if ( !update_time_heap.empty() && processor != nullptr ) {
+            new_snapshot->expiry_time = update_time_heap.front().first + processor->get_timeout();
+        }
+        std::atomic_store(&snapshot, std::shared_ptr<const vehicle_list_snapshot>(std::move(new_snapshot)));
+    }
+
+    void vehicle_list::parse_update( const std::string &update, parsed_update &parsed ) const {
+        try{
+            parsed.v_id = processor->get_vehicle_id(update, parsed.doc);
+            parsed.is_valid = true;
+        }
+        catch( const status_intent_processing_exception &ex) {
+            SPDLOG_CRITICAL("Failed to parse status and intent update: {0}", ex.what());
+        }
+    }
+
+    void vehicle_list::apply_update( const parsed_update &parsed ) {
+        try{
+            vehicle vehicle;
+            auto it = vehicles.map->find(parsed.v_id);
+            if ( it != vehicles.map->end() ) {
+                // If vehicle is already in Vehicle List, update vehicle
+                vehicle = *it->second;
+                processor->process_status_intent( parsed.doc, vehicle);
+                update_vehicle(vehicle);
+                SPDLOG_DEBUG("Update Vehicle : {0}" , vehicle._id);
             }
             else {
-                it ++;
+                // If vehicle is not already in Vehicle list, add vehicle
+                processor->process_status_intent( parsed.doc, vehicle);
+                add_vehicle(vehicle);
+                SPDLOG_DEBUG("Added Vehicle : {0}" , vehicle._id);
+
             }
         }
-
+        catch( const status_intent_processing_exception &ex) {
+            SPDLOG_CRITICAL("Failed to parse status and intent update: {0}", ex.what());
+        }
     }
 
     void vehicle_list::process_update( const std::string &update ) {
       
         if ( processor != nullptr ) {
+            parsed_update parsed;
+            parse_update(update, parsed);
             // Write lock for purge/update/add
             std::unique_lock  lock(vehicle_list_lock);
             purge_old_vehicles( processor->get_timeout());
-            try{
-                vehicle vehicle;
-                rapidjson::Document doc;
-                std::string v_id = processor->get_vehicle_id(update, doc);
-                if ( vehicles.find(v_id) != vehicles.end() ) {
-                    // If vehicle is already in Vehicle List, update vehicle
-                    vehicle = vehicles.find(v_id)->second;
-                    processor->process_status_intent( doc, vehicle);
-                    update_vehicle(vehicle);
-                    SPDLOG_DEBUG("Update Vehicle : {0}" , vehicle._id);
-                }
-                else {
-                    // If vehicle is not already in Vehicle list, add vehicle
-                    processor->process_status_intent( doc, vehicle);
-                    add_vehicle(vehicle);
-                    SPDLOG_DEBUG("Added Vehicle : {0}" , vehicle._id);
+            if ( parsed.is_valid ) {
+                apply_update(parsed);
+                version++;
+            }
+        }
+        else {
+            SPDLOG_CRITICAL("No status_intent_processor available! Set status_intent_processor for vehicle_list!");
+        }
+        
+    }
 
+    void vehicle_list::process_updates( const std::vector<std::string> &updates ) {
+      
+        if ( processor != nullptr ) {
+            // Parse without lock, the updates are split into contiguous ranges, one per thread
+            std::vector<parsed_update> parsed(updates.size());
+            auto parse_range = [this, &updates, &parsed](size_t begin, size_t end) {
+                for ( size_t i = begin; i < end; i++ ) {
+                    parse_update(updates[i], parsed[i]);
+                }
+            };
+            size_t thread_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), updates.size() / MIN_UPDATES_PER_PARSE_THREAD);
+            if ( thread_count <= 1 ) {
+                parse_range(0, updates.size());
+            }
+            else {
+                size_t range_size = (updates.size() + thread_count - 1) / thread_count;
+                std::vector<std::future<void>> parsers;
+                for ( size_t begin = range_size; begin < updates.size(); begin += range_size ) {
+                    parsers.push_back(std::async(std::launch::async, parse_range, begin, std::min(begin + range_size, updates.size())));
+                }
+                // First range on the calling thread
+                parse_range(0, std::min(range_size, updates.size()));
+                for ( auto &parser : parsers ) {
+                    parser.get();
                 }
             }
-            catch( const status_intent_processing_exception &ex) {
-                SPDLOG_CRITICAL("Failed to parse status and intent update: {0}", ex.what());
+            // Single write lock for purge/update/add of whole batch
+            std::unique_lock  lock(vehicle_list_lock);
+            purge_old_vehicles( processor->get_timeout());
+            for ( const auto &update : parsed ) {
+                if ( update.is_valid ) {
+                    apply_update(update);
+                }
             }
+            // The snapshot is built lazily by the next reader
+            version++;
         }
         else {
             SPDLOG_CRITICAL("No status_intent_processor available! Set status_intent_processor for vehicle_list!");
@@ -114,7 +322,12 @@ namespace streets_vehicles {
         // Write Lock
         std::unique_lock  lock(vehicle_list_lock);
         SPDLOG_WARN("Clearing Vehicle list!");
-        vehicles.clear();
+        vehicles = shared_vehicle_map{std::make_shared<vehicle_ptr_map>(), publish_count};
+        vehicles_by_lane.clear();
+        vehicles_by_state.clear();
+        update_time_heap.clear();
+        version++;
+        publish_snapshot();
 
     }
 
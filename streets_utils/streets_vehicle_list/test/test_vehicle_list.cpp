@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include <spdlog/spdlog.h>
 #include <fstream>
+#include <algorithm>
 
 using namespace streets_vehicles;
 
@@ -146,6 +147,52 @@ TEST_F(vehicle_list_test, parse_valid_json) {
 
 }
 
+TEST_F(vehicle_list_test, process_updates_batch) {
+    // Test initialization
+    ASSERT_EQ(veh_list->get_vehicles().size(), 0);
+    // Set timeout to 10 year in milliseconds.
+    veh_list->get_processor()->set_timeout(3.154e11);
+    
+    // Load Vehicle Update
+    std::vector<std::string> updates = load_vehicle_update("../test/test_data/updates.json");
+    // Apply first two updates as a single batch
+    veh_list->process_updates(std::vector<std::string>(updates.begin(), updates.begin() + 2));
+    ASSERT_EQ( veh_list->get_vehicles().size(), 2);
+    ASSERT_EQ( veh_list->get_vehicles_by_state(vehicle_state::EV).size(), 2);
+    ASSERT_EQ( veh_list->get_vehicles_by_lane(5).begin()->_id, "DOT-508");
+    ASSERT_EQ( veh_list->get_vehicles_by_lane(7).begin()->_id, "DOT-507");
+    // Empty batch is a no-op
+    veh_list->process_updates(std::vector<std::string>());
+    ASSERT_EQ( veh_list->get_vehicles().size(), 2);
+}
+
+TEST_F(vehicle_list_test, process_updates_parallel_parse) {
+    // Set timeout to 10 year in milliseconds.
+    veh_list->get_processor()->set_timeout(3.154e11);
+    std::vector<std::string> updates = load_vehicle_update("../test/test_data/updates.json");
+    // Batch large enough to be parsed by several threads, with invalid updates in between
+    std::vector<std::string> batch;
+    while ( batch.size() < 8 * vehicle_list::MIN_UPDATES_PER_PARSE_THREAD ) {
+        batch.insert(batch.end(), updates.begin(), updates.end());
+        batch.push_back("{ invalid json");
+    }
+    vehicle_list sequential_list;
+    sequential_list.set_processor(veh_list->get_processor());
+    for ( const auto &update : batch ) {
+        sequential_list.process_update(update);
+    }
+    veh_list->process_updates(batch);
+
+    auto vehicles = veh_list->get_vehicles();
+    auto sequential_vehicles = sequential_list.get_vehicles();
+    ASSERT_EQ(sequential_vehicles.size(), vehicles.size());
+    for ( const auto &id_vehicle : sequential_vehicles ) {
+        ASSERT_EQ(id_vehicle.second._cur_time, vehicles.at(id_vehicle.first)._cur_time);
+        ASSERT_EQ(id_vehicle.second._cur_state, vehicles.at(id_vehicle.first)._cur_state);
+        ASSERT_EQ(id_vehicle.second._cur_lane_id, vehicles.at(id_vehicle.first)._cur_lane_id);
+    }
+}
+
 TEST_F(vehicle_list_test, parse_invalid_json) {
     // Test initialization
     auto vehicles = veh_list->get_vehicles();
@@ -198,4 +245,81 @@ TEST_F(vehicle_list_test, parse_timeout_json) {
     }
     SPDLOG_INFO("Processed all updates!");
 
-}
\ No newline at end of file
+}
+
+TEST_F(vehicle_list_test, snapshots) {
+    auto empty_snapshot = veh_list->get_snapshot();
+    ASSERT_TRUE(empty_snapshot->vehicles->empty());
+    // Set timeout to 10 years in milliseconds.
+    veh_list->get_processor()->set_timeout(3.154e11);
+
+    std::vector<std::string> updates = load_vehicle_update("../test/test_data/updates.json");
+    veh_list->process_update(updates[0]);
+    auto first_snapshot = veh_list->get_snapshot();
+    ASSERT_GT(first_snapshot->version, empty_snapshot->version);
+    ASSERT_EQ(1, first_snapshot->vehicles->size());
+    // Reading again without a change returns the same snapshot
+    ASSERT_EQ(first_snapshot, veh_list->get_snapshot());
+
+    veh_list->process_update(updates[1]);
+    auto second_snapshot = veh_list->get_snapshot();
+    ASSERT_GT(second_snapshot->version, first_snapshot->version);
+    ASSERT_EQ(2, second_snapshot->vehicles->size());
+    // Published snapshots are not modified
+    ASSERT_TRUE(empty_snapshot->vehicles->empty());
+    ASSERT_EQ(1, first_snapshot->vehicles->size());
+    ASSERT_EQ(second_snapshot->vehicles->size(), second_snapshot->copy_vehicles().size());
+
+    veh_list->clear();
+    ASSERT_TRUE(veh_list->get_snapshot()->vehicles->empty());
+    ASSERT_EQ(2, second_snapshot->vehicles->size());
+}
+
+TEST_F(vehicle_list_test, lane_and_state_indexes) {
+    // Set timeout to 10 years in milliseconds.
+    veh_list->get_processor()->set_timeout(3.154e11);
+    std::vector<std::string> updates = load_vehicle_update("../test/test_data/updates.json");
+    for ( int i = 0; i < 5; i++ ) {
+        veh_list->process_update(updates[i]);
+    }
+    auto snapshot = veh_list->get_snapshot();
+    // Vehicles are moved between index entries on update
+    ASSERT_EQ(1, snapshot->get_vehicles_by_state(vehicle_state::RDV).size());
+    ASSERT_EQ(snapshot->vehicles->at("DOT-507"), snapshot->get_vehicles_by_state(vehicle_state::RDV).at("DOT-507"));
+    ASSERT_EQ(1, snapshot->get_vehicles_by_state(vehicle_state::EV).size());
+    ASSERT_EQ(snapshot->vehicles->at("DOT-508"), snapshot->get_vehicles_by_state(vehicle_state::EV).at("DOT-508"));
+    ASSERT_TRUE(snapshot->get_vehicles_by_state(vehicle_state::DV).empty());
+    size_t indexed_by_lane = 0;
+    for ( const auto &lane_vehicles : snapshot->vehicles_by_lane ) {
+        ASSERT_FALSE(lane_vehicles.second->empty());
+        for ( const auto &id_vehicle : *lane_vehicles.second ) {
+            ASSERT_EQ(lane_vehicles.first, id_vehicle.second->_cur_lane_id);
+        }
+        indexed_by_lane += lane_vehicles.second->size();
+    }
+    ASSERT_EQ(snapshot->vehicles->size(), indexed_by_lane);
+    ASSERT_TRUE(snapshot->get_vehicles_by_lane(-1).empty());
+
+    veh_list->clear();
+    ASSERT_TRUE(veh_list->get_snapshot()->vehicles_by_lane.empty());
+    ASSERT_TRUE(veh_list->get_snapshot()->vehicles_by_state.empty());
+    // Published snapshots keep their indexes
+    ASSERT_EQ(1, snapshot->get_vehicles_by_state(vehicle_state::EV).size());
+}
+
+TEST_F(vehicle_list_test, snapshot_expiry_time) {
+    // Set timeout to 10 years in milliseconds.
+    uint64_t timeout = 3.154e11;
+    veh_list->get_processor()->set_timeout(timeout);
+    std::vector<std::string> updates = load_vehicle_update("../test/test_data/updates.json");
+    // Enough repeated updates to rebuild the update time heap
+    for ( int i = 0; i < 20; i++ ) {
+        veh_list->process_updates(updates);
+        auto snapshot = veh_list->get_snapshot();
+        uint64_t expected_expiry_time = std::numeric_limits<uint64_t>::max();
+        for ( const auto &id_vehicle : *snapshot->vehicles ) {
+            expected_expiry_time = std::min(expected_expiry_time, id_vehicle.second->_cur_time + timeout);
+        }
+        ASSERT_EQ(expected_expiry_time, snapshot->expiry_time);
+    }
+}
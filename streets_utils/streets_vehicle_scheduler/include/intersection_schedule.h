@@ -7,6 +7,24 @@
 #include "vehicle.h"
 
 namespace streets_vehicle_scheduler {
+    /**
+     * @brief rapidjson output stream appending to a std::string. Intersection schedules are serialized straight into
+     * the string returned by toJson() instead of being copied out of a rapidjson::StringBuffer.
+     */
+    class string_output_stream {
+        public:
+            typedef char Ch;
+
+            explicit string_output_stream(std::string &str) : str_(str) {}
+
+            void Put(Ch c) { str_.push_back(c); }
+
+            void Flush() {}
+
+        private:
+            std::string &str_;
+    };
+
     /**
      * @brief Object to represent schedule for single vehicle.
      */
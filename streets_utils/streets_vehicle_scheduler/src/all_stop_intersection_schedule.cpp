@@ -65,10 +65,10 @@ namespace streets_vehicle_scheduler {
         }
         doc.AddMember("payload", json_sched, allocator);
 
-        rapidjson::StringBuffer buffer;                
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        std::string string_sched;
+        string_output_stream os(string_sched);
+        rapidjson::Writer<string_output_stream> writer(os);
         doc.Accept(writer);
-        std::string string_sched = buffer.GetString();
 
         return string_sched;
     }
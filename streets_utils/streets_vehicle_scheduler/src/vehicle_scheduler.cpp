@@ -1,5 +1,7 @@
 #include "vehicle_scheduler.h"
 
+#include <algorithm>
+
 namespace streets_vehicle_scheduler {
     std::shared_ptr<OpenAPI::OAIIntersection_info> vehicle_scheduler::get_intersection_info() const{
         return intersection_info;
@@ -90,11 +92,17 @@ namespace streets_vehicle_scheduler {
                 // TODO: Could add lanelet transition estimation with intersection model information.
                 veh._cur_distance =  0.0;
             }
-            // Remove all future points not older than timestamp for estimation.
-            for (auto it = veh._future_info.begin() ; it != veh._future_info.end(); it++ ) {
-                if ( timestamp > it->timestamp ) {
-                    veh._future_info.erase( it--);
+            // Remove all future points not older than timestamp for estimation. The future path is shared with
+            // other copies of the vehicle, replace it only if points are removed.
+            if ( veh._future_info != nullptr && std::any_of(veh._future_info->begin(), veh._future_info->end(),
+                    [timestamp](const streets_vehicles::future_information &fi) { return timestamp > fi.timestamp; }) ) {
+                auto future_info = std::make_shared<std::vector<streets_vehicles::future_information>>();
+                for ( const auto &fi : *veh._future_info ) {
+                    if ( timestamp <= fi.timestamp ) {
+                        future_info->push_back(fi);
+                    }
                 }
+                veh._future_info = std::move(future_info);
             }
 
         }
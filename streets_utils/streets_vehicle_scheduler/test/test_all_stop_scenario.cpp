@@ -78,7 +78,7 @@ TEST_F(all_stop_scenario_test, one_dv_two_rdvs){
     veh_dv._entry_lane_id = 163;
     veh_dv._link_id = 160;
     veh_dv._exit_lane_id = 164;
-    veh_dv._direction = "right";
+    veh_dv._direction = streets_vehicles::turn_direction::RIGHT;
     veh_dv._departure_position = 1;
     veh_dv._access = true;
     veh_dv._actual_st = schedule->timestamp - 3000;
@@ -97,7 +97,7 @@ TEST_F(all_stop_scenario_test, one_dv_two_rdvs){
     veh_rdv1._entry_lane_id = 171;
     veh_rdv1._link_id = 165;
     veh_rdv1._exit_lane_id = 164;
-    veh_rdv1._direction = "straight";
+    veh_rdv1._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_rdv1._departure_position = 2;
     veh_rdv1._actual_st = schedule->timestamp - 1000;
 
@@ -114,7 +114,7 @@ TEST_F(all_stop_scenario_test, one_dv_two_rdvs){
     veh_rdv2._entry_lane_id = 167;
     veh_rdv2._link_id = 169;
     veh_rdv2._exit_lane_id = 168;
-    veh_rdv2._direction = "straight";
+    veh_rdv2._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_rdv2._departure_position = 3;
     veh_rdv2._actual_st = schedule->timestamp - 1000;
 
@@ -200,7 +200,7 @@ TEST_F(all_stop_scenario_test, two_dvs_two_rdvs_three_evs){
     veh_dv1._entry_lane_id = 163;
     veh_dv1._link_id = 160;
     veh_dv1._exit_lane_id = 164;
-    veh_dv1._direction = "right";
+    veh_dv1._direction = streets_vehicles::turn_direction::RIGHT;
     veh_dv1._departure_position = 2;
     veh_dv1._access = true;
     veh_dv1._actual_st = schedule->timestamp - 3000;
@@ -219,7 +219,7 @@ TEST_F(all_stop_scenario_test, two_dvs_two_rdvs_three_evs){
     veh_dv2._entry_lane_id = 167;
     veh_dv2._link_id = 169;
     veh_dv2._exit_lane_id = 168;
-    veh_dv2._direction = "straight";
+    veh_dv2._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_dv2._departure_position = 1;
     veh_dv2._access = true;
     veh_dv2._actual_st = schedule->timestamp - 5000;
@@ -238,7 +238,7 @@ TEST_F(all_stop_scenario_test, two_dvs_two_rdvs_three_evs){
     veh_rdv1._entry_lane_id = 171;
     veh_rdv1._link_id = 165;
     veh_rdv1._exit_lane_id = 164;
-    veh_rdv1._direction = "straight";
+    veh_rdv1._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_rdv1._departure_position = 3;
     veh_rdv1._actual_st = schedule->timestamp - 1000;
 
@@ -255,7 +255,7 @@ TEST_F(all_stop_scenario_test, two_dvs_two_rdvs_three_evs){
     veh_rdv2._entry_lane_id = 167;
     veh_rdv2._link_id = 155;
     veh_rdv2._exit_lane_id = 154;
-    veh_rdv2._direction = "left";
+    veh_rdv2._direction = streets_vehicles::turn_direction::LEFT;
     veh_rdv2._departure_position = 4;
     veh_rdv2._actual_st = schedule->timestamp;
 
@@ -272,7 +272,7 @@ TEST_F(all_stop_scenario_test, two_dvs_two_rdvs_three_evs){
     veh_ev1._entry_lane_id = 163;
     veh_ev1._link_id = 160;
     veh_ev1._exit_lane_id = 164;
-    veh_ev1._direction = "right";
+    veh_ev1._direction = streets_vehicles::turn_direction::RIGHT;
 
     vehicle veh_ev2;
     veh_ev2._id = "TEST_EV_02";
@@ -287,7 +287,7 @@ TEST_F(all_stop_scenario_test, two_dvs_two_rdvs_three_evs){
     veh_ev2._entry_lane_id = 167;
     veh_ev2._link_id = 169;
     veh_ev2._exit_lane_id = 168;
-    veh_ev2._direction = "straight";
+    veh_ev2._direction = streets_vehicles::turn_direction::STRAIGHT;
 
     vehicle veh_ev3;
     veh_ev3._id = "TEST_EV_03";
@@ -302,7 +302,7 @@ TEST_F(all_stop_scenario_test, two_dvs_two_rdvs_three_evs){
     veh_ev3._entry_lane_id = 167;
     veh_ev3._link_id = 155;
     veh_ev3._exit_lane_id = 154;
-    veh_ev3._direction = "left";
+    veh_ev3._direction = streets_vehicles::turn_direction::LEFT;
 
 
 
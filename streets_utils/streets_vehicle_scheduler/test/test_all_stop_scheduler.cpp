@@ -84,7 +84,7 @@ TEST_F(all_stop_scheduler_test, one_ev_without_cruising){
     veh._entry_lane_id = 167;
     veh._link_id = 169;
     veh._exit_lane_id = 168;
-    veh._direction = "straight";
+    veh._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list,schedule);
@@ -129,7 +129,7 @@ TEST_F(all_stop_scheduler_test, two_vehicles_one_stops_updating){
     veh._entry_lane_id = 167;
     veh._link_id = 169;
     veh._exit_lane_id = 168;
-    veh._direction = "straight";
+    veh._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_list.insert({veh._id,veh});
 
     vehicle veh2;
@@ -145,7 +145,7 @@ TEST_F(all_stop_scheduler_test, two_vehicles_one_stops_updating){
     veh2._entry_lane_id = 167;
     veh2._link_id = 169;
     veh2._exit_lane_id = 168;
-    veh2._direction = "straight";
+    veh2._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_list.insert({veh2._id,veh2});
 
     scheduler->schedule_vehicles(veh_list,schedule);
@@ -190,7 +190,7 @@ TEST_F(all_stop_scheduler_test, two_vehicles_one_invalid_future_timestamp){
     veh._entry_lane_id = 167;
     veh._link_id = 169;
     veh._exit_lane_id = 168;
-    veh._direction = "straight";
+    veh._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_list.insert({veh._id,veh});
 
     vehicle veh2;
@@ -206,7 +206,7 @@ TEST_F(all_stop_scheduler_test, two_vehicles_one_invalid_future_timestamp){
     veh2._entry_lane_id = 167;
     veh2._link_id = 169;
     veh2._exit_lane_id = 168;
-    veh2._direction = "straight";
+    veh2._direction = streets_vehicles::turn_direction::STRAIGHT;
     veh_list.insert({veh2._id,veh2});
 
     scheduler->schedule_vehicles(veh_list,schedule);
@@ -244,7 +244,7 @@ TEST_F(all_stop_scheduler_test, one_vehicle_with_cruising){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 162;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh._departure_position = 1;
     veh_list.insert({veh._id,veh});
 
@@ -284,7 +284,7 @@ TEST_F(all_stop_scheduler_test, one_vehicle_with_future_time_estimate){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 162;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list,schedule);
@@ -324,7 +324,7 @@ TEST_F(all_stop_scheduler_test, one_vehicle_lane_transition_with_future_time_est
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 162;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list,schedule);
@@ -367,7 +367,7 @@ TEST_F(all_stop_scheduler_test, one_vehicle_lane_with_zero_acceleration_time){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 162;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list,schedule);
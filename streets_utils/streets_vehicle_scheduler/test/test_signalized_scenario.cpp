@@ -103,7 +103,7 @@ TEST_F(signalized_scenario_test, multiple_evs_one_dv){
     veh_dv._entry_lane_id = 167;
     veh_dv._link_id = 155;
     veh_dv._exit_lane_id = 168;
-    veh_dv._direction = "left";
+    veh_dv._direction = streets_vehicles::turn_direction::LEFT;
     veh_dv._actual_et = schedule->timestamp - 2000;
 
     vehicle veh_ev1;
@@ -122,7 +122,7 @@ TEST_F(signalized_scenario_test, multiple_evs_one_dv){
     veh_ev1._entry_lane_id = 167;
     veh_ev1._link_id = 155;
     veh_ev1._exit_lane_id = 168;
-    veh_ev1._direction = "left";
+    veh_ev1._direction = streets_vehicles::turn_direction::LEFT;
 
     vehicle veh_ev2;
     veh_ev2._id = "TEST_EV_02";
@@ -140,7 +140,7 @@ TEST_F(signalized_scenario_test, multiple_evs_one_dv){
     veh_ev2._entry_lane_id = 167;
     veh_ev2._link_id = 155;
     veh_ev2._exit_lane_id = 168;
-    veh_ev2._direction = "left";
+    veh_ev2._direction = streets_vehicles::turn_direction::LEFT;
 
     vehicle veh_ev3;
     veh_ev3._id = "TEST_EV_03";
@@ -158,7 +158,7 @@ TEST_F(signalized_scenario_test, multiple_evs_one_dv){
     veh_ev3._entry_lane_id = 167;
     veh_ev3._link_id = 155;
     veh_ev3._exit_lane_id = 168;
-    veh_ev3._direction = "left";
+    veh_ev3._direction = streets_vehicles::turn_direction::LEFT;
 
     vehicle veh_ev4;
     veh_ev4._id = "TEST_EV_04";
@@ -176,7 +176,7 @@ TEST_F(signalized_scenario_test, multiple_evs_one_dv){
     veh_ev4._entry_lane_id = 167;
     veh_ev4._link_id = 155;
     veh_ev4._exit_lane_id = 168;
-    veh_ev4._direction = "left";
+    veh_ev4._direction = streets_vehicles::turn_direction::LEFT;
 
     vehicle veh_ev5;
     veh_ev5._id = "TEST_EV_05";
@@ -194,7 +194,7 @@ TEST_F(signalized_scenario_test, multiple_evs_one_dv){
     veh_ev5._entry_lane_id = 171;
     veh_ev5._link_id = 161;
     veh_ev5._exit_lane_id = 162;
-    veh_ev5._direction = "left";
+    veh_ev5._direction = streets_vehicles::turn_direction::LEFT;
 
     vehicle veh_ev6;
     veh_ev6._id = "TEST_EV_06";
@@ -212,7 +212,7 @@ TEST_F(signalized_scenario_test, multiple_evs_one_dv){
     veh_ev6._entry_lane_id = 171;
     veh_ev6._link_id = 161;
     veh_ev6._exit_lane_id = 162;
-    veh_ev6._direction = "left";
+    veh_ev6._direction = streets_vehicles::turn_direction::LEFT;
 
 
     veh_list.insert({{veh_dv._id, veh_dv}, {veh_ev1._id, veh_ev1}, {veh_ev2._id, veh_ev2}, {veh_ev3._id, veh_ev3}, {veh_ev4._id, veh_ev4}, {veh_ev5._id, veh_ev5}, {veh_ev6._id, veh_ev6}});
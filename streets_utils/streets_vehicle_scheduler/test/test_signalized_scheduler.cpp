@@ -111,7 +111,7 @@ TEST_F(signalized_scheduler_test, one_dv){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 168;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list, schedule);
@@ -153,7 +153,7 @@ TEST_F(signalized_scheduler_test, one_ev_one_decelration){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 168;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list, schedule);
@@ -205,7 +205,7 @@ TEST_F(signalized_scheduler_test, one_ev_without_cruising){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 168;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list, schedule);
@@ -258,7 +258,7 @@ TEST_F(signalized_scheduler_test, one_ev_with_cruising_1){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 168;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list, schedule);
@@ -313,7 +313,7 @@ TEST_F(signalized_scheduler_test, one_ev_with_cruising_2){
     veh._entry_lane_id = 167;
     veh._link_id = 155;
     veh._exit_lane_id = 168;
-    veh._direction = "left";
+    veh._direction = streets_vehicles::turn_direction::LEFT;
     veh_list.insert({veh._id,veh});
 
     scheduler->schedule_vehicles(veh_list, schedule);
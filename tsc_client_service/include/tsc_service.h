@@ -130,12 +130,15 @@ namespace traffic_signal_controller_service {
              * @param bootstap_server for CARMA-Streets Kafka broker.
              * @param producer_topic name of topic to produce to.
              * @param producer a shared pointer to the consumer to initialize.
+             * @param policy applied when the local producer queue is full. Only producers whose newest message
+             * supersedes all queued messages should use queue_full_policy::DROP_QUEUED.
              * @return true if initialization is successful.
              * @return false if initialization is not successful.
              */
 
             bool initialize_kafka_producer( const std::string &bootstap_server, const std::string &producer_topic, 
-                    std::shared_ptr<kafka_clients::kafka_producer_worker> &producer);
+                    std::shared_ptr<kafka_clients::kafka_producer_worker> &producer,
+                    kafka_clients::queue_full_policy policy = kafka_clients::queue_full_policy::BLOCK);
             /**
              * @brief Initialize Kafka Desired phase plan consumer. 
              * @param bootstap_server for CARMA-Streets Kafka broker.
@@ -15,7 +15,8 @@ namespace traffic_signal_controller_service {
             std::string dpp_consumer_topic = streets_service::streets_configuration::get_string_config("desired_phase_plan_consumer_topic");
             std::string dpp_consumer_group = streets_service::streets_configuration::get_string_config("desired_phase_plan_consumer_group");
             
-            if (!spat_producer && !initialize_kafka_producer(bootstrap_server, spat_topic_name, spat_producer)) {
+            // A newer SPaT supersedes all queued SPaT messages
+            if (!spat_producer && !initialize_kafka_producer(bootstrap_server, spat_topic_name, spat_producer, kafka_clients::queue_full_policy::DROP_QUEUED)) {
                 
                 SPDLOG_ERROR("Failed to initialize kafka spat_producer!");
                 return false;
@@ -27,7 +28,12 @@ namespace traffic_signal_controller_service {
                 SPDLOG_ERROR("Failed to initialize kafka desired_phase_plan_consumer!");
                 return false;
                 
-            }            
+            }
+            // Stale desired phase plans must not be applied to the traffic signal controller. Skip backlog after 
+            // restarts and rebalances.
+            desired_phase_plan_consumer->set_seek_to_latest(streets_service::streets_configuration::get_boolean_config("consumer_seek_to_latest"));
+            desired_phase_plan_consumer->set_max_message_age(streets_service::streets_configuration::get_int_config("consumer_max_message_age_ms"));
+
             // Initialize SNMP Client
             std::string target_ip = streets_service::streets_configuration::get_string_config("target_ip");
             int target_port = streets_service::streets_configuration::get_int_config("target_port");
@@ -102,10 +108,13 @@ namespace traffic_signal_controller_service {
     }
 
     bool tsc_service::initialize_kafka_producer(const std::string &bootstrap_server, const std::string &producer_topic,
-         std::shared_ptr<kafka_clients::kafka_producer_worker> &producer) {
+         std::shared_ptr<kafka_clients::kafka_producer_worker> &producer, kafka_clients::queue_full_policy policy) {
         
         auto client = std::make_unique<kafka_clients::kafka_client>();
         producer = client->create_producer(bootstrap_server, producer_topic);
+        // Only block publishing on the broker when the local producer queue is full
+        producer->set_async(true);
+        producer->set_queue_full_policy(policy);
         if (!producer->init())
         {
             SPDLOG_CRITICAL("Kafka producer initialize error on topic {0}", producer_topic);
@@ -264,9 +273,10 @@ namespace traffic_signal_controller_service {
         desired_phase_plan_consumer->subscribe();
         while (desired_phase_plan_consumer->is_running())
         {
-            const std::string payload = desired_phase_plan_consumer->consume(1000);
-            if (payload.length() != 0)
+            const kafka_clients::kafka_message message = desired_phase_plan_consumer->consume_message(1000);
+            if (!message.empty())
             {
+                const std::string payload(message.payload());
                 SPDLOG_DEBUG("Consumed: {0}", payload);
                 std::scoped_lock<std::mutex> lck{dpp_mtx};
                 monitor_dpp_ptr->update_desired_phase_plan(payload);